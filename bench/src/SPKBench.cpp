@@ -0,0 +1,587 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+// Headless benchmark of SPARK
+//
+// The scenarios of the demos are rebuilt without rendering and updated for a fixed number of frames
+// with a constant step, for each number of threads of the sweep.
+// The time per particle and per frame is reported for the whole update and, when SPARK is built with SPK_PROFILING,
+// for each stage of the update. The peak memory is reported when SPARK is built with SPK_MEMORY_STATISTICS.
+// Note that the benchmark must be built with the same definitions as SPARK.
+//
+// Usage : SPARK_Bench [-f frames] [-w warmupFrames] [-t threads,...] [-s scenario] [-o results.csv]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SPARK.h>
+
+const float PI = 3.14159265358979323846f;
+const float STEP = 1.0f / 60.0f;
+const unsigned int SEED = 0x5BA2C;
+
+////////////////////////////////////////////
+// Scenarios (taken from the SPARK demos) //
+////////////////////////////////////////////
+
+// Explosion demo : several explosions made of 6 groups which are recreated when over
+SPK::Ref<SPK::System> createExplosion(size_t index)
+{
+	SPK::Ref<SPK::Sphere> explosionSphere = SPK::Sphere::create(SPK::Vector3D(0.0f,0.0f,0.0f),0.4f);
+
+	SPK::Ref<SPK::RandomEmitter> smokeEmitter = SPK::RandomEmitter::create();
+	smokeEmitter->setZone(SPK::Sphere::create(SPK::Vector3D(0.0f,0.0f,0.0f),0.6f),false);
+	smokeEmitter->setTank(15);
+	smokeEmitter->setFlow(-1);
+	smokeEmitter->setForce(0.02f,0.04f);
+
+	SPK::Ref<SPK::NormalEmitter> flameEmitter = SPK::NormalEmitter::create();
+	flameEmitter->setZone(explosionSphere);
+	flameEmitter->setTank(15);
+	flameEmitter->setFlow(-1);
+	flameEmitter->setForce(0.06f,0.1f);
+
+	SPK::Ref<SPK::StaticEmitter> flashEmitter = SPK::StaticEmitter::create();
+	flashEmitter->setZone(SPK::Sphere::create(SPK::Vector3D(0.0f,0.0f,0.0f),0.1f));
+	flashEmitter->setTank(3);
+	flashEmitter->setFlow(-1);
+
+	SPK::Ref<SPK::NormalEmitter> spark1Emitter = SPK::NormalEmitter::create();
+	spark1Emitter->setZone(explosionSphere);
+	spark1Emitter->setTank(20);
+	spark1Emitter->setFlow(-1);
+	spark1Emitter->setForce(2.0f,3.0f);
+	spark1Emitter->setInverted(true);
+
+	SPK::Ref<SPK::NormalEmitter> spark2Emitter = SPK::NormalEmitter::create();
+	spark2Emitter->setZone(explosionSphere);
+	spark2Emitter->setTank(400);
+	spark2Emitter->setFlow(-1);
+	spark2Emitter->setForce(0.4f,1.0f);
+	spark2Emitter->setInverted(true);
+
+	SPK::Ref<SPK::StaticEmitter> waveEmitter = SPK::StaticEmitter::create();
+	waveEmitter->setZone(SPK::Point::create());
+	waveEmitter->setTank(1);
+	waveEmitter->setFlow(-1);
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	system->setName("Explosion");
+
+	SPK::Ref<SPK::ColorGraphInterpolator> colorInterpolator;
+	SPK::Ref<SPK::FloatGraphInterpolator> paramInterpolator;
+
+	colorInterpolator = SPK::ColorGraphInterpolator::create();
+	colorInterpolator->addEntry(0.0f,0x33333300);
+	colorInterpolator->addEntry(0.4f,0x33333366,0x33333399);
+	colorInterpolator->addEntry(0.6f,0x33333366,0x33333399);
+	colorInterpolator->addEntry(1.0f,0x33333300);
+
+	SPK::Ref<SPK::Group> smokeGroup = system->createGroup(15);
+	smokeGroup->setName("Smoke");
+	smokeGroup->setPhysicalRadius(0.0f);
+	smokeGroup->setLifeTime(2.5f,3.0f);
+	smokeGroup->addEmitter(smokeEmitter);
+	smokeGroup->setColorInterpolator(colorInterpolator);
+	smokeGroup->setParamInterpolator(SPK::PARAM_SCALE,SPK::FloatRandomInterpolator::create(0.3f,0.4f,0.5f,0.7f));
+	smokeGroup->setParamInterpolator(SPK::PARAM_TEXTURE_INDEX,SPK::FloatRandomInitializer::create(0.0f,4.0f));
+	smokeGroup->setParamInterpolator(SPK::PARAM_ANGLE,SPK::FloatRandomInterpolator::create(0.0f,PI * 0.5f,0.0f,PI * 0.5f));
+	smokeGroup->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,0.05f,0.0f)));
+
+	colorInterpolator = SPK::ColorGraphInterpolator::create();
+	colorInterpolator->addEntry(0.0f,0xFF8033FF);
+	colorInterpolator->addEntry(0.5f,0x995933FF);
+	colorInterpolator->addEntry(1.0f,0x33333300);
+
+	paramInterpolator = SPK::FloatGraphInterpolator::create();
+	paramInterpolator->addEntry(0.0f,0.125f);
+	paramInterpolator->addEntry(0.02f,0.3f,0.4f);
+	paramInterpolator->addEntry(1.0f,0.5f,0.7f);
+
+	SPK::Ref<SPK::Group> flameGroup = system->createGroup(15);
+	flameGroup->setName("Flame");
+	flameGroup->setLifeTime(1.5f,2.0f);
+	flameGroup->addEmitter(flameEmitter);
+	flameGroup->setColorInterpolator(colorInterpolator);
+	flameGroup->setParamInterpolator(SPK::PARAM_SCALE,paramInterpolator);
+	flameGroup->setParamInterpolator(SPK::PARAM_TEXTURE_INDEX,SPK::FloatRandomInitializer::create(0.0f,4.0f));
+	flameGroup->setParamInterpolator(SPK::PARAM_ANGLE,SPK::FloatRandomInterpolator::create(0.0f,PI * 0.5f,0.0f,PI * 0.5f));
+
+	paramInterpolator = SPK::FloatGraphInterpolator::create();
+	paramInterpolator->addEntry(0.0f,0.1f);
+	paramInterpolator->addEntry(0.25f,0.5f,1.0f);
+
+	SPK::Ref<SPK::Group> flashGroup = system->createGroup(3);
+	flashGroup->setName("Flash");
+	flashGroup->setLifeTime(0.2f,0.2f);
+	flashGroup->addEmitter(flashEmitter);
+	flashGroup->setColorInterpolator(SPK::ColorSimpleInterpolator::create(0xFFFFFFFF,0xFFFFFF00));
+	flashGroup->setParamInterpolator(SPK::PARAM_SCALE,paramInterpolator);
+	flashGroup->setParamInterpolator(SPK::PARAM_ANGLE,SPK::FloatRandomInitializer::create(0.0f,2.0f * PI));
+
+	SPK::Ref<SPK::Group> spark1Group = system->createGroup(20);
+	spark1Group->setName("Spark 1");
+	spark1Group->setPhysicalRadius(0.0f);
+	spark1Group->setLifeTime(0.2f,1.0f);
+	spark1Group->addEmitter(spark1Emitter);
+	spark1Group->setColorInterpolator(SPK::ColorSimpleInterpolator::create(0xFFFFFFFF,0xFFFFFF00));
+	spark1Group->setParamInterpolator(SPK::PARAM_SCALE,SPK::FloatRandomInitializer::create(0.1f,0.2f));
+	spark1Group->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-0.75f,0.0f)));
+
+	SPK::Ref<SPK::Group> spark2Group = system->createGroup(400);
+	spark2Group->setName("Spark 2");
+	spark2Group->setGraphicalRadius(0.01f);
+	spark2Group->setLifeTime(1.0f,3.0f);
+	spark2Group->addEmitter(spark2Emitter);
+	spark2Group->setColorInterpolator(SPK::ColorRandomInterpolator::create(0xFFFFB2FF,0xFFFFB2FF,0xFF4C4C00,0xFFFF4C00));
+	spark2Group->setParamInterpolator(SPK::PARAM_MASS,SPK::FloatRandomInitializer::create(0.5f,2.5f));
+	spark2Group->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-0.1f,0.0f)));
+	spark2Group->addModifier(SPK::Friction::create(0.4f));
+
+	paramInterpolator = SPK::FloatGraphInterpolator::create();
+	paramInterpolator->addEntry(0.0f,0.0f);
+	paramInterpolator->addEntry(0.2f,0.0f);
+	paramInterpolator->addEntry(1.0f,3.0f);
+
+	SPK::Ref<SPK::Group> waveGroup = system->createGroup(1);
+	waveGroup->setName("Wave");
+	waveGroup->setLifeTime(0.8f,0.8f);
+	waveGroup->addEmitter(waveEmitter);
+	waveGroup->setColorInterpolator(SPK::ColorSimpleInterpolator::create(0xFFFFFF20,0xFFFFFF00));
+	waveGroup->setParamInterpolator(SPK::PARAM_SCALE,paramInterpolator);
+
+	system->getTransform().setPosition(SPK::Vector3D((index % 8) * 4.0f,0.0f,(index / 8) * 4.0f));
+	system->updateTransform();
+
+	return system;
+}
+
+// Flakes demo : a lot of immortal particles bouncing on a sphere
+SPK::Ref<SPK::System> createFlakes(size_t index)
+{
+	SPK::Ref<SPK::Sphere> sphere = SPK::Sphere::create(SPK::Vector3D(),1.0f);
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	system->setName("Flakes");
+
+	SPK::Ref<SPK::Group> group = system->createGroup(100000);
+	group->setRadius(0.0f);
+	group->setColorInterpolator(SPK::ColorDefaultInitializer::create(0xFFCC4C66));
+	group->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-0.5f,0.0f)));
+	group->addModifier(SPK::Friction::create(0.2f));
+	group->addModifier(SPK::Obstacle::create(sphere,0.9f,0.9f));
+	group->setImmortal(true);
+
+	group->addParticles(100000,sphere,SPK::Vector3D());
+	group->flushBufferedParticles();
+
+	return system;
+}
+
+// Collision demo : particles colliding with each other in a box
+SPK::Ref<SPK::System> createCollision(size_t index)
+{
+	SPK::Ref<SPK::Box> cube = SPK::Box::create(SPK::Vector3D(),SPK::Vector3D(1.4f,1.4f,1.4f));
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	system->setName("Collision");
+
+	SPK::Ref<SPK::Group> group = system->createGroup(750);
+	group->setImmortal(true);
+	group->setRadius(0.06f);
+	group->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-1.5f,0.0f)));
+	group->addModifier(SPK::Obstacle::create(cube,0.8f,0.9f,SPK::ZONE_TEST_INTERSECT));
+	group->addModifier(SPK::Collider::create(0.8f));
+	group->addModifier(SPK::Friction::create(0.2f));
+
+	group->addParticles(750,cube,SPK::Vector3D());
+	group->flushBufferedParticles();
+
+	return system;
+}
+
+// Mass collision : the collision demo scaled up to 100000 particles, with the collisions resolved in parallel
+SPK::Ref<SPK::System> createMassCollision(size_t index)
+{
+	SPK::Ref<SPK::Box> cube = SPK::Box::create(SPK::Vector3D(),SPK::Vector3D(7.2f,7.2f,7.2f));
+
+	SPK::Ref<SPK::Collider> collider = SPK::Collider::create(0.8f);
+	collider->setParallel(true);
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	system->setName("Mass collision");
+
+	SPK::Ref<SPK::Group> group = system->createGroup(100000);
+	group->setImmortal(true);
+	group->setRadius(0.06f);
+	group->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-1.5f,0.0f)));
+	group->addModifier(SPK::Obstacle::create(cube,0.8f,0.9f,SPK::ZONE_TEST_INTERSECT));
+	group->addModifier(collider);
+	group->addModifier(SPK::Friction::create(0.2f));
+
+	group->addParticles(100000,cube,SPK::Vector3D());
+	group->flushBufferedParticles();
+
+	return system;
+}
+
+// Rain : drops emitted continuously above the ground and destroyed when reaching it
+SPK::Ref<SPK::System> createRain(size_t index)
+{
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	system->setName("Rain");
+
+	SPK::Ref<SPK::Group> group = system->createGroup(50000);
+	group->setRadius(0.0f);
+	group->setLifeTime(2.0f,2.0f);
+	group->setColorInterpolator(SPK::ColorDefaultInitializer::create(0x99B2FFFF));
+	group->addEmitter(SPK::StraightEmitter::create(
+		SPK::Vector3D(0.0f,-1.0f,0.0f),
+		SPK::Box::create(SPK::Vector3D(0.0f,10.0f,0.0f),SPK::Vector3D(20.0f,0.2f,20.0f)),
+		true,-1,20000.0f,8.0f,10.0f));
+	group->addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-2.0f,0.0f)));
+	group->addModifier(SPK::Destroyer::create(SPK::Plane::create(SPK::Vector3D(),SPK::Vector3D(0.0f,1.0f,0.0f))));
+
+	return system;
+}
+
+// Gravitation : immortal particles attracted by several point masses
+SPK::Ref<SPK::System> createGravitation(size_t index)
+{
+	SPK::Ref<SPK::Sphere> sphere = SPK::Sphere::create(SPK::Vector3D(),2.0f);
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	system->setName("Gravitation");
+
+	SPK::Ref<SPK::Group> group = system->createGroup(20000);
+	group->setRadius(0.0f);
+	group->setImmortal(true);
+	group->setColorInterpolator(SPK::ColorDefaultInitializer::create(0x6680FFFF));
+	group->addModifier(SPK::PointMass::create(SPK::Vector3D(1.0f,0.0f,0.0f),1.5f,0.05f));
+	group->addModifier(SPK::PointMass::create(SPK::Vector3D(-1.0f,0.5f,0.0f),1.0f,0.05f));
+	group->addModifier(SPK::PointMass::create(SPK::Vector3D(0.0f,-0.5f,1.0f),1.0f,0.05f));
+	group->addModifier(SPK::Friction::create(0.05f));
+
+	group->addParticles(20000,sphere,SPK::Vector3D());
+	group->flushBufferedParticles();
+
+	return system;
+}
+
+struct Scenario
+{
+	const char* name;
+	SPK::Ref<SPK::System> (*createSystem)(size_t index);
+	size_t nbSystems;
+};
+
+const size_t NB_SCENARIOS = 6;
+const Scenario SCENARIOS[NB_SCENARIOS] =
+{
+	{ "explosion",		&createExplosion,	32 },
+	{ "flakes",			&createFlakes,		1 },
+	{ "collision",		&createCollision,	1 },
+	{ "masscollision",	&createMassCollision,	1 },
+	{ "rain",			&createRain,		1 },
+	{ "gravitation",	&createGravitation,	1 },
+};
+
+#ifdef SPK_PROFILING
+const char* const STAGE_NAMES[SPK::NB_PROFILE_STAGES] =
+{
+	"emission",
+	"integration",
+	"interpolation",
+	"octree",
+	"modifiers",
+	"renderer",
+	"death",
+	"distances",
+	"sorting",
+	"aabb",
+};
+#endif
+
+/////////
+// Run //
+/////////
+
+struct Result
+{
+	std::string scenario;
+	size_t nbThreads;
+	size_t nbFrames;
+	double nbParticles;			// Sum of the number of particles alive at the end of each frame
+	double totalTime;			// In nanoseconds
+#ifdef SPK_PROFILING
+	double stageTimes[SPK::NB_PROFILE_STAGES];	// In nanoseconds, summed over all the threads
+#endif
+#ifdef SPK_MEMORY_STATISTICS
+	size_t peakMemory;
+	size_t peakParticlesMemory;
+#endif
+
+	double getTimePerParticle(double time) const
+	{
+		return nbParticles > 0.0 ? time / nbParticles : 0.0;
+	}
+};
+
+Result run(const Scenario& scenario,size_t nbThreads,size_t nbFrames,size_t nbWarmupFrames)
+{
+	Result result;
+	result.scenario = scenario.name;
+	result.nbThreads = nbThreads;
+	result.nbFrames = nbFrames;
+	result.nbParticles = 0.0;
+	result.totalTime = 0.0;
+#ifdef SPK_PROFILING
+	for (size_t i = 0; i < SPK::NB_PROFILE_STAGES; ++i)
+		result.stageTimes[i] = 0.0;
+#endif
+
+	SPK::ThreadPool threadPool(nbThreads);
+
+#ifdef SPK_MEMORY_STATISTICS
+	SPK::MemoryStatistics::get().resetPeakSizes();
+#endif
+
+	std::vector<SPK::Ref<SPK::System> > systems(scenario.nbSystems);
+	for (size_t i = 0; i < systems.size(); ++i)
+	{
+		systems[i] = scenario.createSystem(i);
+		systems[i]->setTaskManager(&threadPool);
+		systems[i]->setRandomSeed(static_cast<unsigned int>(SEED + i));
+#ifdef SPK_PROFILING
+		systems[i]->enableProfiling(true);
+#endif
+	}
+
+	for (size_t frame = 0; frame < nbWarmupFrames + nbFrames; ++frame)
+	{
+		const bool measured = frame >= nbWarmupFrames;
+
+		for (size_t i = 0; i < systems.size(); ++i)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			const bool alive = systems[i]->updateParticles(STEP);
+			const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+			if (measured)
+			{
+				result.totalTime += std::chrono::duration<double,std::nano>(end - start).count();
+				result.nbParticles += systems[i]->getNbParticles();
+#ifdef SPK_PROFILING
+				const SPK::StatsCounters& counters = systems[i]->getStats().frame;
+				for (size_t j = 0; j < SPK::NB_PROFILE_STAGES; ++j)
+					result.stageTimes[j] += counters.stageTimes[j] * 1000000.0; // From milliseconds to nanoseconds
+#endif
+			}
+
+			// Systems which are over are replaced (not measured)
+			if (!alive)
+			{
+				systems[i] = scenario.createSystem(i);
+				systems[i]->setTaskManager(&threadPool);
+				systems[i]->setRandomSeed(static_cast<unsigned int>(SEED + i + frame * systems.size()));
+#ifdef SPK_PROFILING
+				systems[i]->enableProfiling(true);
+#endif
+			}
+		}
+	}
+
+#ifdef SPK_MEMORY_STATISTICS
+	result.peakMemory = SPK::MemoryStatistics::get().getPeakSize();
+	result.peakParticlesMemory = SPK::MemoryStatistics::get().getPeakSize(SPK::MEMORY_PARTICLES);
+#endif
+
+	return result;
+}
+
+////////////
+// Output //
+////////////
+
+void writeHeader(std::ostream& out)
+{
+	out << "scenario,threads,frames,particles_per_frame,ns_per_particle_frame";
+#ifdef SPK_PROFILING
+	for (size_t i = 0; i < SPK::NB_PROFILE_STAGES; ++i)
+		out << ",ns_per_particle_frame_" << STAGE_NAMES[i];
+#endif
+#ifdef SPK_MEMORY_STATISTICS
+	out << ",peak_memory_bytes,peak_particles_memory_bytes";
+#endif
+	out << '\n';
+}
+
+void writeResult(std::ostream& out,const Result& result)
+{
+	out << result.scenario << ','
+		<< result.nbThreads << ','
+		<< result.nbFrames << ','
+		<< result.nbParticles / result.nbFrames << ','
+		<< result.getTimePerParticle(result.totalTime);
+#ifdef SPK_PROFILING
+	for (size_t i = 0; i < SPK::NB_PROFILE_STAGES; ++i)
+		out << ',' << result.getTimePerParticle(result.stageTimes[i]);
+#endif
+#ifdef SPK_MEMORY_STATISTICS
+	out << ',' << result.peakMemory << ',' << result.peakParticlesMemory;
+#endif
+	out << '\n';
+}
+
+void printResult(const Result& result)
+{
+	std::cout << std::left << std::setw(12) << result.scenario
+		<< std::right << std::setw(3) << result.nbThreads << " threads : "
+		<< std::fixed << std::setprecision(2) << std::setw(8) << result.getTimePerParticle(result.totalTime) << " ns/particle/frame"
+		<< " (" << static_cast<size_t>(result.nbParticles / result.nbFrames) << " particles)";
+#ifdef SPK_MEMORY_STATISTICS
+	std::cout << ", peak memory " << result.peakMemory / 1024 << " KB";
+#endif
+	std::cout << std::endl;
+
+#ifdef SPK_PROFILING
+	for (size_t i = 0; i < SPK::NB_PROFILE_STAGES; ++i)
+		if (result.stageTimes[i] > 0.0)
+			std::cout << "    " << std::left << std::setw(14) << STAGE_NAMES[i]
+				<< std::right << std::setw(8) << result.getTimePerParticle(result.stageTimes[i]) << std::endl;
+#endif
+}
+
+//////////
+// Main //
+//////////
+
+std::vector<size_t> parseThreads(const char* str)
+{
+	std::vector<size_t> threads;
+	std::istringstream stream(str);
+	std::string token;
+	while (std::getline(stream,token,','))
+	{
+		const int nbThreads = std::atoi(token.c_str());
+		if (nbThreads > 0)
+			threads.push_back(static_cast<size_t>(nbThreads));
+	}
+	return threads;
+}
+
+std::vector<size_t> getDefaultThreads()
+{
+	size_t nbHardwareThreads = std::thread::hardware_concurrency();
+	if (nbHardwareThreads == 0)
+		nbHardwareThreads = 1;
+
+	std::vector<size_t> threads;
+	for (size_t nbThreads = 1; nbThreads < nbHardwareThreads; nbThreads *= 2)
+		threads.push_back(nbThreads);
+	threads.push_back(nbHardwareThreads);
+	return threads;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t nbFrames = 600;
+	size_t nbWarmupFrames = 60;
+	std::vector<size_t> threads = getDefaultThreads();
+	const char* scenarioName = NULL;
+	const char* outputPath = NULL;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i],"-f") == 0 && hasValue)
+			nbFrames = static_cast<size_t>(std::max(1,std::atoi(argv[++i])));
+		else if (std::strcmp(argv[i],"-w") == 0 && hasValue)
+			nbWarmupFrames = static_cast<size_t>(std::max(0,std::atoi(argv[++i])));
+		else if (std::strcmp(argv[i],"-t") == 0 && hasValue)
+			threads = parseThreads(argv[++i]);
+		else if (std::strcmp(argv[i],"-s") == 0 && hasValue)
+			scenarioName = argv[++i];
+		else if (std::strcmp(argv[i],"-o") == 0 && hasValue)
+			outputPath = argv[++i];
+		else
+		{
+			std::cout << "Usage : " << argv[0] << " [-f frames] [-w warmupFrames] [-t threads,...] [-s scenario] [-o results.csv]" << std::endl;
+			return 1;
+		}
+	}
+
+	if (threads.empty())
+	{
+		std::cout << "No valid number of threads" << std::endl;
+		return 1;
+	}
+
+	SPK::System::setClampStep(false);
+	SPK::System::useConstantStep(STEP);
+
+	std::ofstream file;
+	if (outputPath != NULL)
+	{
+		file.open(outputPath);
+		if (!file)
+		{
+			std::cout << "Unable to open " << outputPath << std::endl;
+			return 1;
+		}
+		writeHeader(file);
+	}
+
+	bool found = false;
+	for (size_t i = 0; i < NB_SCENARIOS; ++i)
+	{
+		if (scenarioName != NULL && std::strcmp(scenarioName,SCENARIOS[i].name) != 0)
+			continue;
+
+		found = true;
+		for (size_t j = 0; j < threads.size(); ++j)
+		{
+			const Result result = run(SCENARIOS[i],threads[j],nbFrames,nbWarmupFrames);
+			printResult(result);
+			if (file.is_open())
+				writeResult(file,result);
+		}
+	}
+
+	if (!found)
+	{
+		std::cout << "Unknown scenario " << scenarioName << std::endl;
+		return 1;
+	}
+
+	SPK_DUMP_MEMORY
+	return 0;
+}
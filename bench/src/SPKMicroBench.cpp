@@ -0,0 +1,500 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+// Micro benchmark of the components of SPARK
+//
+// Each modifier, interpolator, emitter and zone is measured alone over synthetic groups of particles of several sizes.
+// Modifiers, interpolators and emitters are driven through the group which calls them : the time of a same group
+// without the component (the baseline) is subtracted so that only the cost of the component remains.
+// Zones are called directly.
+// All runs are single threaded and seeded identically, and the best time of several repetitions is kept,
+// so that results can be compared between builds of SPARK.
+//
+// Usage : SPARK_MicroBench [-n particles,...] [-r repetitions] [-c category] [-o results.csv]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <SPARK.h>
+
+const float STEP = 1.0f / 60.0f;
+const unsigned int SEED = 0x5BA2C;
+const size_t NB_ELEMENTS_PER_REPETITION = 2000000; // Number of particles processed per repetition (at least 1 frame)
+const float DENSITY_SIDE = 2.0f; // Side of the cube holding 1000 particles, the density is kept for all sizes
+
+class Timer
+{
+public :
+
+	Timer() : start(std::chrono::steady_clock::now()) {}
+
+	double getElapsedTime() const // In nanoseconds
+	{
+		return std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+private :
+
+	std::chrono::steady_clock::time_point start;
+};
+
+size_t getNbIterations(size_t nbParticles)
+{
+	return std::max<size_t>(1,NB_ELEMENTS_PER_REPETITION / nbParticles);
+}
+
+// Gets the side of the cube in which particles are generated
+float getSide(size_t nbParticles)
+{
+	return DENSITY_SIDE * std::pow(nbParticles / 1000.0f,1.0f / 3.0f);
+}
+
+////////////////////////////////////////////////////
+// Group components (modifiers and interpolators) //
+////////////////////////////////////////////////////
+
+typedef void (*GroupSetup)(SPK::Group& group,float side);
+
+void setupCollider(SPK::Group& group,float side)		{ group.addModifier(SPK::Collider::create(0.8f)); }
+void setupObstacle(SPK::Group& group,float side)		{ group.addModifier(SPK::Obstacle::create(SPK::Box::create(SPK::Vector3D(),SPK::Vector3D(side,side,side)),0.8f,0.9f)); }
+void setupVortex(SPK::Group& group,float side)			{ group.addModifier(SPK::Vortex::create(SPK::Vector3D(),SPK::Vector3D(0.0f,1.0f,0.0f),1.0f,0.5f)); }
+void setupPointMass(SPK::Group& group,float side)		{ group.addModifier(SPK::PointMass::create(SPK::Vector3D(),1.0f,0.05f)); }
+void setupLinearForce(SPK::Group& group,float side)		{ group.addModifier(SPK::LinearForce::create(SPK::Vector3D(0.0f,1.0f,0.0f))); }
+void setupLinearForceZoned(SPK::Group& group,float side)	{ group.addModifier(SPK::LinearForce::create(SPK::Vector3D(0.0f,1.0f,0.0f),SPK::Sphere::create(SPK::Vector3D(),side * 0.5f))); }
+void setupRandomForce(SPK::Group& group,float side)		{ group.addModifier(SPK::RandomForce::create(SPK::Vector3D(-1.0f,-1.0f,-1.0f),SPK::Vector3D(1.0f,1.0f,1.0f),0.1f,0.5f)); }
+void setupDestroyer(SPK::Group& group,float side)		{ group.addModifier(SPK::Destroyer::create(SPK::Sphere::create(SPK::Vector3D(side * 10.0f,0.0f,0.0f),1.0f))); } // Never destroys
+void setupGravity(SPK::Group& group,float side)			{ group.addModifier(SPK::Gravity::create(SPK::Vector3D(0.0f,-1.0f,0.0f))); }
+void setupFriction(SPK::Group& group,float side)		{ group.addModifier(SPK::Friction::create(0.2f)); }
+void setupRotator(SPK::Group& group,float side)			{ group.addModifier(SPK::Rotator::create()); group.setParamInterpolator(SPK::PARAM_ROTATION_SPEED,SPK::FloatDefaultInitializer::create(1.0f)); }
+
+SPK::Ref<SPK::ColorGraphInterpolator> createColorGraph()
+{
+	SPK::Ref<SPK::ColorGraphInterpolator> interpolator = SPK::ColorGraphInterpolator::create();
+	interpolator->addEntry(0.0f,0xFF000000);
+	interpolator->addEntry(0.3f,0xFFFF00FF);
+	interpolator->addEntry(0.6f,0x00FF00FF);
+	interpolator->addEntry(1.0f,0x0000FF00);
+	return interpolator;
+}
+
+SPK::Ref<SPK::FloatGraphInterpolator> createFloatGraph()
+{
+	SPK::Ref<SPK::FloatGraphInterpolator> interpolator = SPK::FloatGraphInterpolator::create();
+	interpolator->addEntry(0.0f,0.0f);
+	interpolator->addEntry(0.3f,1.0f,2.0f);
+	interpolator->addEntry(0.6f,2.0f);
+	interpolator->addEntry(1.0f,0.0f);
+	return interpolator;
+}
+
+void setupColorDefault(SPK::Group& group,float side)	{ group.setColorInterpolator(SPK::ColorDefaultInitializer::create(0xFF8033FF)); }
+void setupColorRandomInit(SPK::Group& group,float side)	{ group.setColorInterpolator(SPK::ColorRandomInitializer::create(0xFF0000FF,0x0000FFFF)); }
+void setupColorSimple(SPK::Group& group,float side)		{ group.setColorInterpolator(SPK::ColorSimpleInterpolator::create(0xFFFFFFFF,0xFF000000)); }
+void setupColorRandom(SPK::Group& group,float side)		{ group.setColorInterpolator(SPK::ColorRandomInterpolator::create(0xFFFFB2FF,0xFFFFB2FF,0xFF4C4C00,0xFFFF4C00)); }
+void setupColorGraph(SPK::Group& group,float side)		{ group.setColorInterpolator(createColorGraph()); }
+void setupFloatDefault(SPK::Group& group,float side)	{ group.setParamInterpolator(SPK::PARAM_SCALE,SPK::FloatDefaultInitializer::create(1.0f)); }
+void setupFloatRandomInit(SPK::Group& group,float side)	{ group.setParamInterpolator(SPK::PARAM_SCALE,SPK::FloatRandomInitializer::create(0.5f,1.5f)); }
+void setupFloatSimple(SPK::Group& group,float side)		{ group.setParamInterpolator(SPK::PARAM_SCALE,SPK::FloatSimpleInterpolator::create(0.0f,1.0f)); }
+void setupFloatRandom(SPK::Group& group,float side)		{ group.setParamInterpolator(SPK::PARAM_SCALE,SPK::FloatRandomInterpolator::create(0.0f,0.5f,1.0f,1.5f)); }
+void setupFloatGraph(SPK::Group& group,float side)		{ group.setParamInterpolator(SPK::PARAM_SCALE,createFloatGraph()); }
+
+struct GroupComponent
+{
+	const char* category;
+	const char* name;
+	GroupSetup setup;
+};
+
+const GroupComponent GROUP_COMPONENTS[] =
+{
+	{ "modifier",		"Collider",					&setupCollider },
+	{ "modifier",		"Obstacle",					&setupObstacle },
+	{ "modifier",		"Vortex",					&setupVortex },
+	{ "modifier",		"PointMass",				&setupPointMass },
+	{ "modifier",		"LinearForce",				&setupLinearForce },
+	{ "modifier",		"LinearForce (zoned)",		&setupLinearForceZoned },
+	{ "modifier",		"RandomForce",				&setupRandomForce },
+	{ "modifier",		"Destroyer",				&setupDestroyer },
+	{ "modifier",		"Gravity",					&setupGravity },
+	{ "modifier",		"Friction",					&setupFriction },
+	{ "modifier",		"Rotator",					&setupRotator },
+	{ "interpolator",	"ColorDefaultInitializer",	&setupColorDefault },
+	{ "interpolator",	"ColorRandomInitializer",	&setupColorRandomInit },
+	{ "interpolator",	"ColorSimpleInterpolator",	&setupColorSimple },
+	{ "interpolator",	"ColorRandomInterpolator",	&setupColorRandom },
+	{ "interpolator",	"ColorGraphInterpolator",	&setupColorGraph },
+	{ "interpolator",	"FloatDefaultInitializer",	&setupFloatDefault },
+	{ "interpolator",	"FloatRandomInitializer",	&setupFloatRandomInit },
+	{ "interpolator",	"FloatSimpleInterpolator",	&setupFloatSimple },
+	{ "interpolator",	"FloatRandomInterpolator",	&setupFloatRandom },
+	{ "interpolator",	"FloatGraphInterpolator",	&setupFloatGraph },
+};
+const size_t NB_GROUP_COMPONENTS = sizeof(GROUP_COMPONENTS) / sizeof(GroupComponent);
+
+// Creates a system with a group of particles at rest in a cube
+SPK::Ref<SPK::System> createSyntheticSystem(size_t nbParticles,GroupSetup setup)
+{
+	const float side = getSide(nbParticles);
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	SPK::Ref<SPK::Group> group = system->createGroup(nbParticles);
+	group->setRadius(0.01f);
+	group->setLifeTime(1000.0f,1000.0f); // Particles do not die during the benchmark
+	if (setup != NULL)
+		setup(*group,side);
+
+	system->setRandomSeed(SEED);
+	group->addParticles(nbParticles,SPK::Box::create(SPK::Vector3D(),SPK::Vector3D(side,side,side)),SPK::Vector3D());
+	group->flushBufferedParticles();
+
+	return system;
+}
+
+// Gets the best time per particle of the update of a synthetic group
+double measureGroup(size_t nbParticles,size_t nbRepetitions,GroupSetup setup)
+{
+	const size_t nbIterations = getNbIterations(nbParticles);
+	double bestTime = std::numeric_limits<double>::max();
+
+	for (size_t i = 0; i < nbRepetitions; ++i)
+	{
+		SPK::Ref<SPK::System> system = createSyntheticSystem(nbParticles,setup);
+		system->updateParticles(STEP); // First update out of the measure (allocations, octree...)
+
+		const Timer timer;
+		for (size_t j = 0; j < nbIterations; ++j)
+			system->updateParticles(STEP);
+		bestTime = std::min(bestTime,timer.getElapsedTime() / (nbIterations * nbParticles));
+	}
+
+	return bestTime;
+}
+
+//////////////
+// Emitters //
+//////////////
+
+SPK::Ref<SPK::Emitter> createStaticEmitter()	{ return SPK::StaticEmitter::create(); }
+SPK::Ref<SPK::Emitter> createRandomEmitter()	{ return SPK::RandomEmitter::create(); }
+SPK::Ref<SPK::Emitter> createStraightEmitter()	{ return SPK::StraightEmitter::create(SPK::Vector3D(0.0f,1.0f,0.0f)); }
+SPK::Ref<SPK::Emitter> createSphericEmitter()	{ return SPK::SphericEmitter::create(SPK::Vector3D(0.0f,1.0f,0.0f),0.0f,1.0f); }
+SPK::Ref<SPK::Emitter> createNormalEmitter()	{ return SPK::NormalEmitter::create(SPK::Sphere::create()); }
+
+struct EmitterComponent
+{
+	const char* name;
+	SPK::Ref<SPK::Emitter> (*create)();
+};
+
+const EmitterComponent EMITTERS[] =
+{
+	{ "StaticEmitter",		&createStaticEmitter },
+	{ "RandomEmitter",		&createRandomEmitter },
+	{ "StraightEmitter",	&createStraightEmitter },
+	{ "SphericEmitter",		&createSphericEmitter },
+	{ "NormalEmitter",		&createNormalEmitter },
+};
+const size_t NB_EMITTERS = sizeof(EMITTERS) / sizeof(EmitterComponent);
+
+// Gets the best time per particle of the addition of particles to a group, with an emitter or with a constant velocity if NULL
+double measureEmission(size_t nbParticles,size_t nbRepetitions,const SPK::Ref<SPK::Emitter>& emitter)
+{
+	const size_t nbIterations = getNbIterations(nbParticles);
+	double bestTime = std::numeric_limits<double>::max();
+
+	SPK::Ref<SPK::System> system = SPK::System::create(true);
+	SPK::Ref<SPK::Group> group = system->createGroup(nbParticles);
+	group->setLifeTime(1000.0f,1000.0f);
+
+	for (size_t i = 0; i < nbRepetitions; ++i)
+	{
+		system->setRandomSeed(SEED);
+
+		double time = 0.0;
+		for (size_t j = 0; j < nbIterations; ++j)
+		{
+			group->empty();
+
+			const Timer timer;
+			if (emitter)
+				group->addParticles(nbParticles,SPK::Vector3D(),emitter);
+			else
+				group->addParticles(nbParticles,SPK::Vector3D(),SPK::Vector3D(0.0f,1.0f,0.0f));
+			group->flushBufferedParticles();
+			time += timer.getElapsedTime();
+		}
+		bestTime = std::min(bestTime,time / (nbIterations * nbParticles));
+	}
+
+	return bestTime;
+}
+
+///////////
+// Zones //
+///////////
+
+SPK::Ref<SPK::Zone> createPoint(float side)		{ return SPK::Point::create(); }
+SPK::Ref<SPK::Zone> createSphere(float side)	{ return SPK::Sphere::create(SPK::Vector3D(),side * 0.4f); }
+SPK::Ref<SPK::Zone> createPlane(float side)		{ return SPK::Plane::create(SPK::Vector3D(),SPK::Vector3D(0.0f,1.0f,0.0f)); }
+SPK::Ref<SPK::Zone> createRing(float side)		{ return SPK::Ring::create(SPK::Vector3D(),SPK::Vector3D(0.0f,1.0f,0.0f),side * 0.2f,side * 0.4f); }
+SPK::Ref<SPK::Zone> createBox(float side)		{ return SPK::Box::create(SPK::Vector3D(),SPK::Vector3D(side,side,side) * 0.8f); }
+SPK::Ref<SPK::Zone> createCylinder(float side)	{ return SPK::Cylinder::create(SPK::Vector3D(),side * 0.8f,side * 0.4f); }
+
+struct ZoneComponent
+{
+	const char* name;
+	SPK::Ref<SPK::Zone> (*create)(float side);
+};
+
+const ZoneComponent ZONES[] =
+{
+	{ "Point",		&createPoint },
+	{ "Sphere",		&createSphere },
+	{ "Plane",		&createPlane },
+	{ "Ring",		&createRing },
+	{ "Box",		&createBox },
+	{ "Cylinder",	&createCylinder },
+};
+const size_t NB_ZONES = sizeof(ZONES) / sizeof(ZoneComponent);
+
+enum ZoneMethod
+{
+	ZONE_GENERATE_POSITION,
+	ZONE_CONTAINS,
+	ZONE_INTERSECTS,
+};
+
+const char* const ZONE_METHOD_NAMES[] =
+{
+	"generatePosition",
+	"contains",
+	"intersects",
+};
+
+// Gets the best time per call of a method of a zone over a set of random points
+double measureZone(size_t nbParticles,size_t nbRepetitions,const SPK::Ref<SPK::Zone>& zone,ZoneMethod method)
+{
+	const size_t nbIterations = getNbIterations(nbParticles);
+	const float halfSide = getSide(nbParticles) * 0.5f;
+	double bestTime = std::numeric_limits<double>::max();
+
+	zone->updateTransform();
+
+	SPK::RandomGenerator& generator = SPK::SPKContext::get().getDefaultRandomGenerator();
+	generator.setSeed(SEED);
+
+	std::vector<SPK::Vector3D> points(nbParticles + 1);
+	for (size_t i = 0; i < points.size(); ++i)
+		points[i] = generator.generate(SPK::Vector3D(-halfSide,-halfSide,-halfSide),SPK::Vector3D(halfSide,halfSide,halfSide));
+
+	size_t nbHits = 0; // Prevents the calls from being optimized away
+	for (size_t i = 0; i < nbRepetitions; ++i)
+	{
+		generator.setSeed(SEED);
+
+		const Timer timer;
+		for (size_t j = 0; j < nbIterations; ++j)
+			switch (method)
+			{
+			case ZONE_GENERATE_POSITION :
+				for (size_t k = 0; k < nbParticles; ++k)
+					zone->generatePosition(points[k],(k & 1) == 0,0.01f);
+				break;
+
+			case ZONE_CONTAINS :
+				for (size_t k = 0; k < nbParticles; ++k)
+					nbHits += zone->contains(points[k],0.01f);
+				break;
+
+			case ZONE_INTERSECTS :
+				for (size_t k = 0; k < nbParticles; ++k)
+					nbHits += zone->intersects(points[k],points[k + 1],0.01f);
+				break;
+			}
+		bestTime = std::min(bestTime,timer.getElapsedTime() / (nbIterations * nbParticles));
+	}
+
+	if (nbHits == std::numeric_limits<size_t>::max())
+		std::cout << nbHits;
+
+	return bestTime;
+}
+
+////////////
+// Output //
+////////////
+
+class Output
+{
+public :
+
+	Output(const char* path) :
+		file()
+	{
+		if (path != NULL)
+		{
+			file.open(path);
+			file << "category,component,particles,ns_per_particle\n";
+		}
+	}
+
+	bool isValid() const { return !file.is_open() || file.good(); }
+
+	void write(const char* category,const std::string& component,size_t nbParticles,double time)
+	{
+		time = std::max(0.0,time); // The subtraction of the baseline can give slightly negative times for cheap components
+
+		std::cout << std::left << std::setw(14) << category
+			<< std::setw(32) << component
+			<< std::right << std::setw(9) << nbParticles
+			<< std::fixed << std::setprecision(3) << std::setw(12) << time << " ns" << std::endl;
+
+		if (file.is_open())
+			file << category << ',' << component << ',' << nbParticles << ',' << time << '\n';
+	}
+
+private :
+
+	std::ofstream file;
+};
+
+//////////
+// Main //
+//////////
+
+std::vector<size_t> parseSizes(const char* str)
+{
+	std::vector<size_t> sizes;
+	std::istringstream stream(str);
+	std::string token;
+	while (std::getline(stream,token,','))
+	{
+		const int size = std::atoi(token.c_str());
+		if (size > 0)
+			sizes.push_back(static_cast<size_t>(size));
+	}
+	return sizes;
+}
+
+bool isSelected(const char* category,const char* selection)
+{
+	return selection == NULL || std::strcmp(category,selection) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<size_t> sizes;
+	sizes.push_back(1000);
+	sizes.push_back(10000);
+	sizes.push_back(100000);
+	sizes.push_back(1000000);
+	size_t nbRepetitions = 5;
+	const char* category = NULL;
+	const char* outputPath = NULL;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i],"-n") == 0 && hasValue)
+			sizes = parseSizes(argv[++i]);
+		else if (std::strcmp(argv[i],"-r") == 0 && hasValue)
+			nbRepetitions = static_cast<size_t>(std::max(1,std::atoi(argv[++i])));
+		else if (std::strcmp(argv[i],"-c") == 0 && hasValue)
+			category = argv[++i];
+		else if (std::strcmp(argv[i],"-o") == 0 && hasValue)
+			outputPath = argv[++i];
+		else
+		{
+			std::cout << "Usage : " << argv[0] << " [-n particles,...] [-r repetitions] [-c modifier|interpolator|emitter|zone] [-o results.csv]" << std::endl;
+			return 1;
+		}
+	}
+
+	if (sizes.empty())
+	{
+		std::cout << "No valid number of particles" << std::endl;
+		return 1;
+	}
+
+	Output output(outputPath);
+	if (!output.isValid())
+	{
+		std::cout << "Unable to open " << outputPath << std::endl;
+		return 1;
+	}
+
+	SPK::System::setClampStep(false);
+	SPK::System::useConstantStep(STEP);
+
+	for (size_t i = 0; i < sizes.size(); ++i)
+	{
+		const size_t nbParticles = sizes[i];
+
+		double baselineTime = -1.0;
+		for (size_t j = 0; j < NB_GROUP_COMPONENTS; ++j)
+		{
+			const GroupComponent& component = GROUP_COMPONENTS[j];
+			if (!isSelected(component.category,category))
+				continue;
+
+			if (baselineTime < 0.0)
+				baselineTime = measureGroup(nbParticles,nbRepetitions,NULL);
+
+			const double time = measureGroup(nbParticles,nbRepetitions,component.setup);
+			output.write(component.category,component.name,nbParticles,time - baselineTime);
+		}
+
+		if (isSelected("emitter",category))
+		{
+			baselineTime = measureEmission(nbParticles,nbRepetitions,SPK_NULL_REF);
+			for (size_t j = 0; j < NB_EMITTERS; ++j)
+			{
+				const double time = measureEmission(nbParticles,nbRepetitions,EMITTERS[j].create());
+				output.write("emitter",EMITTERS[j].name,nbParticles,time - baselineTime);
+			}
+		}
+
+		if (isSelected("zone",category))
+			for (size_t j = 0; j < NB_ZONES; ++j)
+			{
+				const SPK::Ref<SPK::Zone> zone = ZONES[j].create(getSide(nbParticles));
+				for (size_t k = 0; k <= ZONE_INTERSECTS; ++k)
+				{
+					const double time = measureZone(nbParticles,nbRepetitions,zone,static_cast<ZoneMethod>(k));
+					output.write("zone",std::string(ZONES[j].name) + "::" + ZONE_METHOD_NAMES[k],nbParticles,time);
+				}
+			}
+	}
+
+	SPK_DUMP_MEMORY
+	return 0;
+}
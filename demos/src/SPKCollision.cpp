@@ -204,22 +204,15 @@ void drawBox(float r,float g,float b,const SPK::Vector3D& AABBMin,const SPK::Vec
 	glEnd();
 }
 
-void drawCell(const SPK::Octree& octree,const SPK::Octree::Cell& cell,const SPK::Vector3D& offset,const SPK::Vector3D& dim)
+// Draws the cells of the spatial index holding particles
+void drawSpatialIndex(const SPK::SpatialIndex& spatialIndex,SPK::Group& group)
 {
-	if (!cell.particles.empty())
+	float cellSize = spatialIndex.getCurrentCellSize();
+	for (size_t i = 0; i < group.getNbParticles(); ++i)
 	{
-		drawBox(0.0f,1.0f,0.0f,offset,offset + dim);				
-		if (cell.hasChildren)
-			std::cout << "ANORMAL BEHAVIOR" << std::endl;
-	}
-	else if (cell.hasChildren)
-	{
-		SPK::Vector3D childDim = dim * 0.5f;
-		for (size_t i = 0; i < 8; ++i)
-		{
-			SPK::Vector3D childOffset(((i >> 2) & 1) * childDim.x,((i >> 1) & 1) * childDim.y,(i & 1) * childDim.z);
-			drawCell(octree,octree.getCell(cell.children[i]),childOffset + offset,childDim);
-		}
+		const SPK::Vector3D& pos = group.getParticle(i).position();
+		SPK::Vector3D cellMin(floor(pos.x / cellSize) * cellSize,floor(pos.y / cellSize) * cellSize,floor(pos.z / cellSize) * cellSize);
+		drawBox(0.0f,1.0f,0.0f,cellMin,cellMin + SPK::Vector3D(cellSize));
 	}
 }
 
@@ -419,11 +412,8 @@ int main(int argc, char *argv[])
 
 		//drawBox(0.0f,0.0f,1.0f,SPK::Vector3D(-0.25f),SPK::Vector3D(0.25f));
 
-		if (particleSystem->isAABBComputationEnabled() && particleGroup->getOctree() != NULL)
-		{
-			const SPK::Octree& octree = *particleGroup->getOctree();
-			drawCell(octree,octree.getCell(0),octree.getAABBMin(),octree.getAABBMax() - octree.getAABBMin());
-		}
+		if (particleSystem->isAABBComputationEnabled() && particleGroup->getSpatialIndex() != NULL)
+			drawSpatialIndex(*particleGroup->getSpatialIndex(),*particleGroup);
 
 		drawBoundingBox(*particleSystem);
 		SPK::GL::GLRenderer::saveGLStates();
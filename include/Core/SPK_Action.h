@@ -25,6 +25,7 @@
 namespace SPK
 {
 	class Particle;
+	class Group;
 
 	/**
 	* @brief An abstract class that allows to perform an action on a single particle
@@ -59,6 +60,17 @@ namespace SPK
 		*/
 		virtual void apply(Particle& particle) const = 0;
 
+		/**
+		* @brief Tells whether this action adds particles to a group
+		*
+		* This is used to know how long the particles of a group can live after the death of the particles of the groups feeding it
+		* (see System::prewarm(float,float)). By default an action does not add particles.
+		*
+		* @param group : the group
+		* @return true if the action may add particles to the group, false if not
+		*/
+		virtual bool spawnsInto(const Group& group) const { return false; }
+
 	public :
 		spark_description(Action, SPKObject)
 		(
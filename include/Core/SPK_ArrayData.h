@@ -107,6 +107,9 @@ namespace SPK
 		~ArrayData<T>();
 
 		virtual void swap(size_t index0,size_t index1);
+		virtual void compact(const size_t* sources,const size_t* destinations,size_t nb);
+		virtual bool resize(size_t capacity,size_t nbParticles);
+		virtual size_t getMemorySize() const;
 	};
 
 	typedef ArrayData<float>	FloatArrayData;		/**< @brief ArrayData holding floats */
@@ -184,6 +187,40 @@ namespace SPK
 		for (size_t i = 0; i < sizePerParticle; ++i)
 			std::swap(data[index0 + i],data[index1 + i]);
 	}
+
+	template<typename T>
+	inline void ArrayData<T>::compact(const size_t* sources,const size_t* destinations,size_t nb)
+	{
+		for (size_t i = 0; i < nb; ++i)
+		{
+			const T* src = data + sources[i] * sizePerParticle;
+			T* dst = data + destinations[i] * sizePerParticle;
+			for (size_t j = 0; j < sizePerParticle; ++j)
+				dst[j] = src[j];
+		}
+	}
+
+	template<typename T>
+	inline bool ArrayData<T>::resize(size_t capacity,size_t nbParticles)
+	{
+		size_t newTotalSize = capacity * sizePerParticle;
+		size_t copySize = std::min(nbParticles * sizePerParticle,std::min(newTotalSize,totalSize));
+
+		T* newData = SPK_NEW_ARRAY(T,newTotalSize);
+		for (size_t i = 0; i < copySize; ++i)
+			newData[i] = data[i];
+
+		SPK_DELETE_ARRAY(data);
+		data = newData;
+		totalSize = newTotalSize;
+		return true;
+	}
+
+	template<typename T>
+	inline size_t ArrayData<T>::getMemorySize() const
+	{
+		return totalSize * sizeof(T);
+	}
 }
 
 #endif
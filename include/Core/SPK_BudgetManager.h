@@ -0,0 +1,254 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_BUDGETMANAGER
+#define H_SPK_BUDGETMANAGER
+
+#include <vector>
+#ifndef SPK_NO_THREADS
+#include <atomic>
+#endif
+
+namespace SPK
+{
+	/**
+	* @brief A singleton limiting the number of particles alive in the registered systems
+	*
+	* Systems are registered with a priority, the higher the priority the more important the system.<br>
+	* At each call to update(), the manager counts the particles of all the registered systems and computes an emission scale for each of them.
+	* The emission scale multiplies the number of particles emitted by the emitters of the groups of the system during their update.<br>
+	* <br>
+	* Systems are served by decreasing priority. While the particles of a priority and of all the higher ones stay below the throttle threshold
+	* of the budget, their emission is not scaled. Beyond it, the emission is scaled down linearly to reach 0 at the budget.
+	* Systems sharing the same priority get the same scale.<br>
+	* <br>
+	* Between two updates, the particles born in the groups of the registered systems are taken from the room left in the budget at the last update,
+	* whatever creates them (emitters, Group::addParticles(...), actions or emitter attachers). Particles beyond it are not born.
+	* As particles dying during a frame only give their room back at the next update, the registered systems never exceed the budget by emitting.<br>
+	* When culling is enabled and the budget is exceeded (after the budget was lowered or a system registered), the groups of the systems
+	* with the lowest priorities are emptied until the number of particles gets back within the budget.<br>
+	* <br>
+	* The manager is not thread safe. update() must be called once per frame before updating the systems,
+	* and not while systems are being updated. During the updates, the emission scales are only read and the room left is taken atomically,
+	* so the systems can be updated in parallel.<br>
+	* A system unregisters itself when destroyed.
+	*/
+	class SPK_PREFIX BudgetManager
+	{
+	friend class System;
+	friend class Group;
+
+	public :
+
+		/**
+		* @brief Gets the instance of the budget manager
+		* @return the instance of the budget manager
+		*/
+		static BudgetManager& get();
+
+		////////////
+		// Budget //
+		////////////
+
+		/**
+		* @brief Sets the maximum number of particles of the registered systems
+		* @param budget : the maximum number of particles, 0 for no limit
+		*/
+		void setBudget(size_t budget);
+
+		/**
+		* @brief Gets the maximum number of particles of the registered systems
+		* @return the maximum number of particles, 0 if there is no limit
+		*/
+		size_t getBudget() const;
+
+		/**
+		* @brief Sets the ratio of the budget from which emission starts to be throttled
+		*
+		* The ratio is clamped within [0,1]. A ratio of 1 stops the emission only once the budget is reached.
+		*
+		* @param threshold : the ratio of the budget from which emission is throttled
+		*/
+		void setThrottleThreshold(float threshold);
+
+		/**
+		* @brief Gets the ratio of the budget from which emission starts to be throttled
+		* @return the ratio of the budget from which emission is throttled
+		*/
+		float getThrottleThreshold() const;
+
+		/**
+		* @brief Enables or disables the culling of groups when the budget is exceeded
+		* @param culling : true to enable culling, false to disable it
+		*/
+		void enableCulling(bool culling);
+
+		/**
+		* @brief Tells whether the culling of groups is enabled
+		* @return true if culling is enabled, false if not
+		*/
+		bool isCullingEnabled() const;
+
+		////////////////////////
+		// Systems management //
+		////////////////////////
+
+		/**
+		* @brief Registers a system in the budget manager
+		*
+		* If the system is already registered, only its priority is changed.
+		*
+		* @param system : the system to register
+		* @param priority : the priority of the system
+		*/
+		void registerSystem(const Ref<System>& system,int priority = 0);
+
+		/**
+		* @brief Unregisters a system from the budget manager
+		*
+		* The emission scale of the system is reset to 1.
+		*
+		* @param system : the system to unregister
+		*/
+		void unregisterSystem(const Ref<System>& system);
+
+		/** @brief Unregisters all the systems from the budget manager */
+		void unregisterAllSystems();
+
+		/**
+		* @brief Gets the number of systems registered in the budget manager
+		* @return the number of registered systems
+		*/
+		size_t getNbSystems() const;
+
+		/**
+		* @brief Gets the priority of a registered system
+		* @param system : the system
+		* @return the priority of the system or 0 if it is not registered
+		*/
+		int getPriority(const Ref<System>& system) const;
+
+		////////////
+		// Update //
+		////////////
+
+		/**
+		* @brief Culls groups if needed and computes the emission scales of the registered systems
+		*
+		* The room left in the budget for the particles born until the next update is computed as well.
+		*
+		* This must be called once per frame, before the systems are updated.
+		*/
+		void update();
+
+		/**
+		* @brief Gets the number of particles of the registered systems at the last update
+		* @return the number of particles at the last update
+		*/
+		size_t getNbParticles() const;
+
+		/**
+		* @brief Gets the number of particles culled at the last update
+		* @return the number of particles culled at the last update
+		*/
+		size_t getNbCulledParticles() const;
+
+	private :
+
+		struct Entry
+		{
+			System* system;
+			int priority;
+
+			bool operator<(const Entry& entry) const { return priority > entry.priority; } // Sorted by decreasing priority
+		};
+
+		std::vector<Entry> entries;
+
+		size_t budget;
+		float throttleThreshold;
+		bool cullingEnabled;
+
+		size_t nbParticles;
+		size_t nbCulledParticles;
+
+#ifdef SPK_NO_THREADS
+		typedef size_t Counter;
+#else
+		typedef std::atomic<size_t> Counter;
+#endif
+
+		Counter nbAvailableParticles; // Room left in the budget for the particles born until the next update
+
+		BudgetManager();
+		BudgetManager(const BudgetManager&); // Not used
+		BudgetManager& operator=(const BudgetManager&); // Not used
+
+		void removeSystem(System* system);
+		void cullGroups();
+		void resetAvailableParticles();
+
+		// Takes at most nb particles from the room left in the budget and returns the number taken
+		size_t acquireParticles(size_t nb);
+	};
+
+	inline size_t BudgetManager::getBudget() const
+	{
+		return budget;
+	}
+
+	inline float BudgetManager::getThrottleThreshold() const
+	{
+		return throttleThreshold;
+	}
+
+	inline void BudgetManager::enableCulling(bool culling)
+	{
+		cullingEnabled = culling;
+	}
+
+	inline bool BudgetManager::isCullingEnabled() const
+	{
+		return cullingEnabled;
+	}
+
+	inline void BudgetManager::unregisterSystem(const Ref<System>& system)
+	{
+		removeSystem(system.get());
+	}
+
+	inline size_t BudgetManager::getNbSystems() const
+	{
+		return entries.size();
+	}
+
+	inline size_t BudgetManager::getNbParticles() const
+	{
+		return nbParticles;
+	}
+
+	inline size_t BudgetManager::getNbCulledParticles() const
+	{
+		return nbCulledParticles;
+	}
+}
+
+#endif
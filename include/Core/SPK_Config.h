@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_CONFIG
+#define H_SPK_CONFIG
+
+// Default configuration of SPARK, matching the default options of the core module.
+// It is used when the SPK_Config.h generated by CMake in the build directory of the core module is not in the include path,
+// and must be edited to match the build when SPARK is built without CMake.
+// The options it records change the layout of public classes and must be the same for SPARK and for the code using it.
+
+/**
+* @def SPK_PROFILING
+* @brief Defined when SPARK is built with the profiling statistics of the systems (SPARK_PROFILING)
+*/
+/* #undef SPK_PROFILING */
+
+/**
+* @def SPK_MEMORY_STATISTICS
+* @brief Defined when SPARK is built with the memory statistics (SPARK_MEMORY_STATISTICS)
+*/
+/* #undef SPK_MEMORY_STATISTICS */
+
+/**
+* @def SPK_NO_THREADS
+* @brief Defined when the default task manager of SPARK runs all jobs on the calling thread (SPARK_USE_THREADS off)
+*/
+/* #undef SPK_NO_THREADS */
+
+/**
+* @def SPK_ATOMIC_REFERENCES
+* @brief Defined when the reference counting of SPKObject is atomic (SPARK_ATOMIC_REFERENCES)
+*/
+/* #undef SPK_ATOMIC_REFERENCES */
+
+#endif
@@ -25,6 +25,8 @@
 #include <cstdlib>
 #include <climits>
 
+#include "Core/SPK_Config.h"
+
 // for windows platform only
 #if defined(WIN32) || defined(_WIN32)
 
@@ -47,13 +49,45 @@
 #define SPK_PREFIX
 #endif
 
+/**
+* @def SPK_THREAD_LOCAL
+* @brief Declares a static variable with one instance per thread
+* When SPARK is built with SPK_NO_THREADS defined, the variable is a regular static variable.
+*/
+#if defined(SPK_NO_THREADS)
+#define SPK_THREAD_LOCAL
+#elif defined(_MSC_VER)
+#define SPK_THREAD_LOCAL __declspec(thread)
+#else
+#define SPK_THREAD_LOCAL __thread
+#endif
+
+/**
+* @def SPK_ATOMIC_REFERENCES
+* @brief Makes the reference counting of SPKObject atomic
+* When SPARK is built with SPK_ATOMIC_REFERENCES defined (SPARK_ATOMIC_REFERENCES option of CMake, recorded in SPK_Config.h),
+* Ref can be copied and destroyed concurrently from different threads.
+* This requires a C++11 compiler and makes every copy of a Ref slightly more expensive.
+*/
+
+/**
+* @def SPK_MOVE_SEMANTICS
+* @brief Defined when the compiler supports rvalue references
+* Ref is then movable, which transfers the reference without touching the reference count.
+*/
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define SPK_MOVE_SEMANTICS
+#endif
+
 #include "Core/SPK_MemoryTracer.h"
 #include "Core/SPK_Reference.h"
 #include "Core/SPK_Enum.h"
+#include "Core/SPK_RandomGenerator.h"
 
 /**
 * @brief A macro returning a random value within [min,max[
-* This is a shortcut syntax to <i>SPK::SPKContext::get().generateRandom(min,max)</i>
+* This is a shortcut syntax to <i>SPK::SPKContext::get().generateRandom(min,max)</i><br>
+* The value is drawn from the current random generator of the calling thread (see SPKContext::getRandomGenerator()).
 * @param min : the minimum bound of the interval (inclusive)
 * @param max : the maximum bound of the interval (exclusive)
 * @return a random number within [min,max[
@@ -218,6 +252,7 @@ namespace SPK
 
 		/**
 		* @brief Gets a random value within the interval [min,max[
+		* The value is drawn from the current random generator of the calling thread.
 		* @param min : the minimum bound of the interval (inclusive)
 		* @param max : the maximum bound of the interval (exclusive)
 		* @return a random number within [min,max[
@@ -225,10 +260,33 @@ namespace SPK
 		template<typename T>
 		T generateRandom(const T& min,const T& max);
 
+		/**
+		* @brief Gets the current random generator of the calling thread
+		*
+		* While a group is updated, the current generator of the updating thread is the one of the group.<br>
+		* Otherwise it is the default generator of SPARK, which is seeded with the time at start up and is not thread safe.
+		*
+		* @return the current random generator
+		*/
+		RandomGenerator& getRandomGenerator();
+
+		/**
+		* @brief Sets the current random generator of the calling thread
+		* @param generator : the generator to use or NULL to use the default generator
+		* @return the previous current generator of the calling thread or NULL if it was the default one
+		*/
+		RandomGenerator* setCurrentRandomGenerator(RandomGenerator* generator);
+
+		/**
+		* @brief Gets the default random generator
+		* @return the default random generator
+		*/
+		RandomGenerator& getDefaultRandomGenerator();
+
 	private :
 
 		Ref<Zone> defaultZone;
-		unsigned int randomSeed;
+		RandomGenerator defaultRandomGenerator;
 
 		SPKContext();
 		~SPKContext();
@@ -240,20 +298,12 @@ namespace SPK
 	template<typename T>
 	inline T SPKContext::generateRandom(const T& min,const T& max)
 	{
-		// optimized standard minimal
-		long tmp0 = 16807L * (randomSeed & 0xFFFFL);
-		long tmp1 = 16807L * (randomSeed >> 16);
-		long tmp2 = (tmp0 >> 16) + tmp1;
-		tmp0 = ((tmp0 & 0xFFFF)|((tmp2 & 0x7FFF) << 16)) + (tmp2 >> 15);
-
-		// correction of the error
-		if ((tmp0 & 0x80000000L) != 0)
-			tmp0 = (tmp0 + 1) & 0x7FFFFFFFL;
-
-		randomSeed = tmp0;
+		return getRandomGenerator().generate(min,max);
+	}
 
-		// find a random number in the interval
-		return static_cast<T>(min + ((randomSeed - 1) / 2147483646.0) * (max - min));
+	inline RandomGenerator& SPKContext::getDefaultRandomGenerator()
+	{
+		return defaultRandomGenerator;
 	}
 }
 
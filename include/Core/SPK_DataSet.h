@@ -76,6 +76,44 @@ namespace SPK
 		* @param index1 : index of the second particle
 		*/
 		virtual void swap(size_t index0,size_t index1) = 0;
+
+		/**
+		* @brief Moves the additional data of several particles at once
+		*
+		* The data of particle sources[i] is moved to destinations[i], for i in [0,nb[.<br>
+		* Destinations are slots of dead particles whose data can be overwritten and no index appears twice.<br>
+		* <br>
+		* The default implementation swaps the data of each pair of particles.
+		* Children holding plain values should override it to copy the data instead.
+		*
+		* @param sources : the indices of the particles to move
+		* @param destinations : the indices where to move the particles
+		* @param nb : the number of particles to move
+		*/
+		virtual void compact(const size_t* sources,const size_t* destinations,size_t nb);
+
+		/**
+		* @brief Resizes the data when the capacity of the group changes
+		*
+		* The data of the first nbParticles particles must be kept.<br>
+		* The default implementation returns false, in which case the whole dataset is destroyed
+		* and created again by its datahandler.
+		*
+		* @param capacity : the new capacity of the group
+		* @param nbParticles : the number of particles whose data must be kept
+		* @return true if the data was resized, false if it must be created again
+		*/
+		virtual bool resize(size_t capacity,size_t nbParticles);
+
+		/**
+		* @brief Gets the size in bytes of the memory allocated by the data
+		*
+		* This is used to count the memory of the datasets (see MemoryStatistics).
+		* The default implementation returns 0.
+		*
+		* @return the size in bytes of the memory allocated by the data
+		*/
+		virtual size_t getMemorySize() const;
 	};
 
 	/**
@@ -140,6 +178,12 @@ namespace SPK
 		/** @brief Destroys all the data held */
 		void destroyAllData();
 
+		/**
+		* @brief Gets the size in bytes of the memory allocated by the data held
+		* @return the size in bytes of the memory allocated by the data
+		*/
+		size_t getMemorySize() const;
+
 	private :
 
 		Data** dataArray;
@@ -147,7 +191,8 @@ namespace SPK
 		bool initialized;
 
 		void setInitialized();
-		void swap(size_t index0,size_t index1);
+		void compact(const size_t* sources,const size_t* destinations,size_t nb);
+		void resize(size_t capacity,size_t nbParticles);
 	};
 
 	inline Data::Data() :
@@ -164,6 +209,22 @@ namespace SPK
 		return flag;
 	}
 
+	inline void Data::compact(const size_t* sources,const size_t* destinations,size_t nb)
+	{
+		for (size_t i = 0; i < nb; ++i)
+			swap(sources[i],destinations[i]);
+	}
+
+	inline bool Data::resize(size_t capacity,size_t nbParticles)
+	{
+		return false;
+	}
+
+	inline size_t Data::getMemorySize() const
+	{
+		return 0;
+	}
+
 	inline DataSet::DataSet() :
 		nbData(0),
 		initialized(false),
@@ -201,10 +262,11 @@ namespace SPK
 		setData(index,NULL);
 	}
 
-	inline void DataSet::swap(size_t index0,size_t index1)
+	inline void DataSet::compact(const size_t* sources,const size_t* destinations,size_t nb)
 	{
 		for (size_t i = 0; i < nbData; ++i)
-			dataArray[i]->swap(index0,index1);
+			if (dataArray[i] != NULL)
+				dataArray[i]->compact(sources,destinations,nb);
 	}
 };
 
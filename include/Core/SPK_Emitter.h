@@ -243,9 +243,7 @@ namespace SPK
 
 		mutable float fraction;
 		
-		void emit(Particle& particle) const;
-
-		size_t updateTankFromTime(float deltaTime);
+		size_t updateTankFromTime(float deltaTime,float scale = 1.0f);
 		size_t updateTankFromNb(size_t nb);
 
 		/**
@@ -259,6 +257,19 @@ namespace SPK
 		* @param speed : the desired speed of the particle
 		*/
 		virtual void generateVelocity(Particle& particle,float speed) const = 0;
+
+		/**
+		* @brief Emits the particles of a group within [start,end[
+		*
+		* This is called once for all the particles born from this emitter during an update of the group.<br>
+		* The default implementation generates the positions of all the particles within the zone, then their velocities.
+		* The parameters of the particles (mass...) are initialized when this is called.
+		*
+		* @param group : the group of the particles
+		* @param start : the index of the first particle to emit
+		* @param end : the index after the last particle to emit
+		*/
+		virtual void emitChunk(Group& group,size_t start,size_t end) const;
 	};
 
 	inline void Emitter::setActive(bool active)
@@ -332,7 +343,7 @@ namespace SPK
 		full = f;
 	}
 
-	inline size_t Emitter::updateTankFromTime(float deltaTime)
+	inline size_t Emitter::updateTankFromTime(float deltaTime,float scale)
 	{
 		if (deltaTime < 0.0f)
 			return 0;
@@ -340,12 +351,14 @@ namespace SPK
 		size_t nbBorn;
 		if (flow < 0.0f)
 		{
-			nbBorn = currentTank > 0 ? currentTank : 0;
+			// The whole tank is emptied at once, the part not emitted is dropped
+			nbBorn = currentTank > 0 ? static_cast<size_t>(currentTank * scale) : 0;
 			currentTank = 0;
 		}
 		else if (currentTank != 0)
 		{
-			fraction += flow * deltaTime;
+			// A scaled down flow keeps the particles not emitted in the tank
+			fraction += flow * deltaTime * scale;
 			nbBorn = static_cast<size_t>(fraction);
 			if (currentTank >= 0)
 			{
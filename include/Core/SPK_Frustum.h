@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_FRUSTUM
+#define H_SPK_FRUSTUM
+
+namespace SPK
+{
+	/**
+	* @brief A view frustum used to test the visibility of systems
+	*
+	* The frustum is defined by 6 planes whose normals point inwards.
+	* A point p is on the inner side of a plane (n,d) if <i>dotProduct(n,p) + d >= 0</i>.<br>
+	* <br>
+	* The planes are typically extracted from the view projection matrix of the camera (see setFromMatrix(const float*,bool)).
+	* The frustum must be in the same space as the particles (the world space).
+	*/
+	class Frustum
+	{
+	public :
+
+		/** @brief The planes of a frustum */
+		enum Side
+		{
+			SIDE_LEFT,
+			SIDE_RIGHT,
+			SIDE_BOTTOM,
+			SIDE_TOP,
+			SIDE_NEAR,
+			SIDE_FAR,
+		};
+
+		static const size_t NB_SIDES = 6;
+
+		/** @brief Constructor of frustum, the default frustum contains the whole space */
+		Frustum();
+
+		/**
+		* @brief Constructor of frustum from a view projection matrix
+		* @param matrix : the view projection matrix (see setFromMatrix(const float*,bool))
+		* @param zeroToOneDepth : true if the clip depth is within [0,1] (Direct3D), false if it is within [-1,1] (OpenGL)
+		*/
+		Frustum(const float* matrix,bool zeroToOneDepth = false);
+
+		/**
+		* @brief Sets a plane of the frustum
+		* @param side : the side of the plane
+		* @param normal : the normal of the plane pointing inwards (it does not need to be normalized)
+		* @param distance : the signed distance of the plane
+		*/
+		void setPlane(Side side,const Vector3D& normal,float distance);
+
+		/**
+		* @brief Extracts the planes of the frustum from a view projection matrix
+		*
+		* The matrix is an array of 16 floats laid out as in OpenGL (column major with column vectors).
+		* This is also the layout of Direct3D and Irrlicht matrices (row major with row vectors).
+		*
+		* @param matrix : the view projection matrix
+		* @param zeroToOneDepth : true if the clip depth is within [0,1] (Direct3D), false if it is within [-1,1] (OpenGL)
+		*/
+		void setFromMatrix(const float* matrix,bool zeroToOneDepth = false);
+
+		/**
+		* @brief Gets the normal of a plane of the frustum
+		* @param side : the side of the plane
+		* @return the normalized normal of the plane
+		*/
+		const Vector3D& getNormal(Side side) const;
+
+		/**
+		* @brief Gets the signed distance of a plane of the frustum
+		* @param side : the side of the plane
+		* @return the signed distance of the plane
+		*/
+		float getDistance(Side side) const;
+
+		/**
+		* @brief Tells whether a point is within the frustum
+		* @param point : the point to test
+		* @return true if the point is within the frustum
+		*/
+		bool contains(const Vector3D& point) const;
+
+		/**
+		* @brief Tells whether an axis aligned bounding box intersects the frustum
+		*
+		* The test is conservative : a box outside the frustum but close to one of its corners may be considered as intersecting it.
+		*
+		* @param AABBMin : the minimum coordinates of the box
+		* @param AABBMax : the maximum coordinates of the box
+		* @return true if the box intersects the frustum, false if it is fully outside
+		*/
+		bool intersects(const Vector3D& AABBMin,const Vector3D& AABBMax) const;
+
+	private :
+
+		Vector3D normals[NB_SIDES];
+		float distances[NB_SIDES];
+	};
+
+	inline Frustum::Frustum()
+	{
+		for (size_t i = 0; i < NB_SIDES; ++i)
+			distances[i] = 0.0f; // A null normal and a null distance is always on the inner side
+	}
+
+	inline Frustum::Frustum(const float* matrix,bool zeroToOneDepth)
+	{
+		setFromMatrix(matrix,zeroToOneDepth);
+	}
+
+	inline void Frustum::setPlane(Side side,const Vector3D& normal,float distance)
+	{
+		float norm = normal.getNorm();
+		if (norm > 0.0f)
+		{
+			normals[side] = normal / norm;
+			distances[side] = distance / norm;
+		}
+		else
+		{
+			normals[side].set(0.0f,0.0f,0.0f);
+			distances[side] = 0.0f;
+		}
+	}
+
+	inline void Frustum::setFromMatrix(const float* m,bool zeroToOneDepth)
+	{
+		// The planes are combinations of the rows of the matrix (Gribb and Hartmann method)
+		setPlane(SIDE_LEFT,Vector3D(m[3] + m[0],m[7] + m[4],m[11] + m[8]),m[15] + m[12]);
+		setPlane(SIDE_RIGHT,Vector3D(m[3] - m[0],m[7] - m[4],m[11] - m[8]),m[15] - m[12]);
+		setPlane(SIDE_BOTTOM,Vector3D(m[3] + m[1],m[7] + m[5],m[11] + m[9]),m[15] + m[13]);
+		setPlane(SIDE_TOP,Vector3D(m[3] - m[1],m[7] - m[5],m[11] - m[9]),m[15] - m[13]);
+		if (zeroToOneDepth)
+			setPlane(SIDE_NEAR,Vector3D(m[2],m[6],m[10]),m[14]);
+		else
+			setPlane(SIDE_NEAR,Vector3D(m[3] + m[2],m[7] + m[6],m[11] + m[10]),m[15] + m[14]);
+		setPlane(SIDE_FAR,Vector3D(m[3] - m[2],m[7] - m[6],m[11] - m[10]),m[15] - m[14]);
+	}
+
+	inline const Vector3D& Frustum::getNormal(Side side) const
+	{
+		return normals[side];
+	}
+
+	inline float Frustum::getDistance(Side side) const
+	{
+		return distances[side];
+	}
+
+	inline bool Frustum::contains(const Vector3D& point) const
+	{
+		for (size_t i = 0; i < NB_SIDES; ++i)
+			if (dotProduct(normals[i],point) + distances[i] < 0.0f)
+				return false;
+		return true;
+	}
+
+	inline bool Frustum::intersects(const Vector3D& AABBMin,const Vector3D& AABBMax) const
+	{
+		for (size_t i = 0; i < NB_SIDES; ++i)
+		{
+			// Tests the corner of the box the furthest along the normal of the plane
+			const Vector3D& n = normals[i];
+			Vector3D corner(
+				n.x >= 0.0f ? AABBMax.x : AABBMin.x,
+				n.y >= 0.0f ? AABBMax.y : AABBMin.y,
+				n.z >= 0.0f ? AABBMax.z : AABBMin.z);
+
+			if (dotProduct(n,corner) + distances[i] < 0.0f)
+				return false;
+		}
+		return true;
+	}
+}
+
+#endif
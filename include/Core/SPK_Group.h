@@ -32,6 +32,8 @@ namespace SPK
 	class Particle;
 	class System;
 	class Octree;
+	class SpatialIndex;
+	class TaskManager;
 
 	/**
 	* @brief Group of particles
@@ -55,6 +57,7 @@ namespace SPK
 	friend class Particle;
 	friend class System;
 	friend class DataSet;
+	friend class SpatialIndex;
 
 	public :
 
@@ -91,9 +94,88 @@ namespace SPK
 
 		bool isEnabled(Param param) const;
 
+		/**
+		* @brief Gets the bounds of the values of a parameter of the particles
+		*
+		* The bounds are given by the interpolator of the parameter (see Interpolator::getBounds(T&,T&)) or are the default value
+		* if the parameter is not enabled. Values set by hand on particles are not accounted for.
+		*
+		* @param param : the parameter
+		* @param min : the minimum value of the parameter
+		* @param max : the maximum value of the parameter
+		* @return true if the bounds are known, false if not
+		*/
+		bool getParamBounds(Param param,float& min,float& max) const;
+
 		size_t getNbParticles() const;
 		size_t getCapacity() const;
 
+		/**
+		* @brief Gets the number of particles the storage of the group can hold
+		*
+		* The arrays of particles are contiguous and their size is the capacity rounded up to a multiple of 1024 particles
+		* (smaller groups use their exact capacity). Changing the capacity within that granularity does not reallocate the arrays,
+		* otherwise all of them are reallocated and the particles are copied.<br>
+		* This is greater or equal to the capacity of the group.
+		*
+		* @return the number of particles the storage can hold
+		*/
+		size_t getStorageCapacity() const;
+
+		/**
+		* @brief Enables or disables the automatic management of the capacity
+		*
+		* When enabled, the capacity grows as soon as particles to emit do not fit anymore instead of losing them.
+		* The new capacity is the greatest of the actual need and of the estimated demand (see estimateCapacity()), plus a margin.<br>
+		* When less than half the capacity is used during some time, the capacity shrinks down to the peak use over that period, plus a margin.<br>
+		* <br>
+		* The capacity always stays within the limits set with setAutoCapacityLimits(size_t,size_t).
+		*
+		* @param autoCapacity : true to enable the automatic management of the capacity, false to disable it
+		*/
+		void enableAutoCapacity(bool autoCapacity);
+
+		/**
+		* @brief Tells whether the capacity is automatically managed
+		* @return true if the capacity is automatically managed, false if not
+		*/
+		bool isAutoCapacityEnabled() const;
+
+		/**
+		* @brief Sets the limits of the capacity when it is automatically managed
+		* @param minCapacity : the minimum capacity
+		* @param maxCapacity : the maximum capacity
+		*/
+		void setAutoCapacityLimits(size_t minCapacity,size_t maxCapacity);
+
+		size_t getMinAutoCapacity() const;
+		size_t getMaxAutoCapacity() const;
+
+		/**
+		* @brief Estimates the number of particles alive in the group at steady state
+		*
+		* The estimation is based on the flow and tank of the active emitters and on the maximum life time of particles.<br>
+		* Emitters with an infinite tank emitted at once or in an immortal group cannot be estimated and are not taken into account.
+		*
+		* @return the estimated number of particles, at most the maximum automatic capacity
+		*/
+		size_t estimateCapacity() const;
+
+		/**
+		* @brief Gets the maximum number of particles alive at once since the creation of the group or the last reset
+		* @return the high water mark of the group
+		*/
+		size_t getHighWaterMark() const;
+
+		/**
+		* @brief Gets the number of particles that could not be emitted by lack of capacity since the creation of the group or the last reset
+		* @return the number of lost particles
+		*/
+		size_t getNbLostParticles() const;
+
+		/** @brief Resets the high water mark and the number of lost particles */
+		void resetCapacityStats();
+
 		Particle getParticle(size_t index);
 		const Particle getParticle(size_t index) const;
 
@@ -121,6 +203,50 @@ namespace SPK
 		void enableSorting(bool sorting);
 		bool isSortingEnabled() const;
 
+		/**
+		* @brief Sets the number of particles per chunk when the group is updated in parallel
+		*
+		* When the system of the group has a TaskManager, the per particle stages of the update (integration, chunk safe interpolators and modifiers)
+		* are split into chunks of that size which are processed in parallel.<br>
+		* A group holding less particles than a chunk is always updated serially.
+		*
+		* @param chunkSize : the number of particles per chunk
+		*/
+		void setChunkSize(size_t chunkSize);
+
+		/**
+		* @brief Gets the number of particles per chunk when the group is updated in parallel
+		* @return the number of particles per chunk
+		*/
+		size_t getChunkSize() const;
+
+		/**
+		* @brief Seeds the random generator of the group
+		*
+		* All random draws made during the update of the group (emitters, zones, interpolators, modifiers...) use the generator of the group.
+		*
+		* @param seed : the seed
+		*/
+		void setRandomSeed(unsigned int seed);
+
+		/**
+		* @brief Gets the random generator of the group
+		* @return the random generator of the group
+		*/
+		RandomGenerator& getRandomGenerator();
+
+		/**
+		* @brief Gets the indices of the particles sorted from the furthest to the closest from the camera
+		*
+		* Sorting does not move particles in memory, it only computes this array of indices.
+		* Renderers read particles in that order, typically through a ConstSortedGroupIterator.<br>
+		* The order is computed at the end of each update of the system.
+		* If sorting is disabled or particles were added since the last update, NULL is returned and particles are to be read in storage order.
+		*
+		* @return the sorted indices of the particles or NULL
+		*/
+		const unsigned int* getSortedIndices() const;
+
 		const void* getColorAddress() const;
 		const void* getPositionAddress() const;
 		const void* getVelocityAddress() const;
@@ -294,6 +420,16 @@ namespace SPK
 
 		Ref<System> getSystem() const;
 
+		/**
+		* @brief Gets the task manager of the system of the group
+		*
+		* Modifiers can use it to split their work into jobs while the group is updated.
+		* Unlike getSystem(), this does not take a reference on the system.
+		*
+		* @return the task manager of the system, NULL if there is none
+		*/
+		TaskManager* getTaskManager() const;
+
 		/////////////
 		// Actions //
 		/////////////
@@ -361,6 +497,28 @@ namespace SPK
 		*/
 		Octree* getOctree();
 
+		/**
+		* @brief Gets the spatial index
+		* A group will have a spatial index only if at least one of its modifiers has requested it.
+		* @return the spatial index if some or NULL otherwise
+		*/
+		SpatialIndex* getSpatialIndex();
+
+#ifdef SPK_PROFILING
+		///////////////
+		// Profiling //
+		///////////////
+
+		/**
+		* @brief Gets the statistics of the profiling of the group
+		*
+		* The statistics are only gathered when profiling is enabled on the system of the group (see System::enableProfiling(bool)).
+		*
+		* @return the statistics of the group
+		*/
+		const Stats& getStats() const;
+#endif
+
 		///////////////////////
 		// Virtual interface //
 		///////////////////////
@@ -371,6 +529,7 @@ namespace SPK
 		spark_description(Group, Transformable)
 		(
 			spk_attribute(unsigned int, capacity, reallocate, getCapacity);
+			spk_attribute(bool, autoCapacity, enableAutoCapacity, isAutoCapacityEnabled);
 			spk_attribute(Pair<float>, lifeTime, setLifeTime, getMinLifeTime, getMaxLifeTime);
 			spk_attribute(bool, immortal, setImmortal, isImmortal);
 			spk_attribute(bool, still, setStill, isStill);
@@ -396,6 +555,14 @@ namespace SPK
 		static const size_t NB_PARAMETERS = 5;
 		static const float DEFAULT_VALUES[NB_PARAMETERS];
 
+		static const size_t DEFAULT_CHUNK_SIZE = 4096;
+		static const float AUTO_CAPACITY_MARGIN;			// Ratio applied to the needed capacity when growing or shrinking
+		static const float AUTO_CAPACITY_SHRINK_THRESHOLD;	// Ratio of the capacity under which the capacity is considered too big
+		static const float AUTO_CAPACITY_SHRINK_DELAY;		// Time the capacity must be too big before it shrinks
+
+		static const size_t CAPACITY_GRANULARITY = 1024; // The storage of groups with a larger capacity is rounded up to a multiple of this number of particles
+		static const size_t SORT_INSERTION_THRESHOLD = 64; // Under this number of particles, sorting is always done by insertion
+
 		// This holds the structure of arrays (SOA) containing data of particles
 		struct ParticleData
 		{
@@ -403,6 +570,7 @@ namespace SPK
 
 			size_t nbParticles;
 			size_t maxParticles;
+			size_t nbAllocated;
 
 			// Particles attributes
 			Vector3D* positions;
@@ -422,6 +590,7 @@ namespace SPK
 				initialized(false),
 				nbParticles(0),
 				maxParticles(0),
+				nbAllocated(0),
 				positions(NULL),
 				velocities(NULL),
 				oldPositions(NULL),
@@ -512,6 +681,32 @@ namespace SPK
 		typedef DataHandlerDef<Ref<ColorInterpolator> > ColorInterpolatorDef;
 		typedef DataHandlerDef<Ref<FloatInterpolator> > FloatInterpolatorDef;
 
+		// The per particle stages of the update, executed in order
+		enum UpdateStageType
+		{
+			UPDATE_STAGE_INTEGRATION,
+			UPDATE_STAGE_COLOR_INTERPOLATOR,
+			UPDATE_STAGE_PARAM_INTERPOLATOR,
+			UPDATE_STAGE_OCTREE,
+			UPDATE_STAGE_SPATIAL_INDEX,
+			UPDATE_STAGE_MODIFIER,
+		};
+
+		struct UpdateStage
+		{
+			UpdateStageType type;
+			size_t index; // index of the parameter or of the active modifier
+			bool chunkSafe;
+
+			UpdateStage(UpdateStageType type,size_t index,bool chunkSafe) :
+				type(type),
+				index(index),
+				chunkSafe(chunkSafe)
+			{}
+		};
+
+		class UpdateChunkTask;
+
 		// Functor used to sort modifiers by priority
 		struct CompareModifierPriority
 		{
@@ -548,6 +743,36 @@ namespace SPK
 		mutable std::vector<WeakModifierDef> activeModifiers;
 		mutable std::vector<WeakModifierDef> initModifiers;
 
+		std::vector<UpdateStage> updateStages;
+		size_t chunkSize;
+
+		// The lists of modifiers, the update stages and the handlers with data are only rebuilt when the handlers change
+		typedef std::pair<const DataHandler*,DataSet*> PreparedDataHandler;
+		std::vector<PreparedDataHandler> preparedDataHandlers;
+		bool additionnalDataDirty;
+
+		RandomGenerator randomGenerator;
+
+		bool autoCapacityEnabled;
+		size_t minAutoCapacity;
+		size_t maxAutoCapacity;
+		float lowUsageTime;
+		size_t lowUsagePeak;
+
+		size_t highWaterMark;
+		size_t nbLostParticles;
+
+		// Buffers used to remove dead particles (kept between updates to avoid reallocations)
+		std::vector<size_t> deadIndices;
+		std::vector<size_t> compactionSources;
+
+		// Positions interpolated for rendering
+		std::vector<Vector3D> renderPositions;
+
+		// Depth order of the particles and buffer used to sort it
+		std::vector<unsigned int> sortedIndices;
+		std::vector<unsigned int> sortBuffer;
+
 		RendererDef renderer;
 
 		Ref<Action> birthAction;
@@ -570,30 +795,75 @@ namespace SPK
 		float graphicalRadius;
 
 		Octree* octree;
+		SpatialIndex* spatialIndex;
+
+#ifdef SPK_PROFILING
+		// Profiling
+		Stats stats;
+		bool profilingEnabled; // Set by the system for the current frame
+		std::vector<float> stageTimes; // Time spent in each update stage by each chunk
+
+		void beginStatsFrame(bool profiling);
+		void endStatsFrame(float averageWeight);
+		void collectStageTimes(size_t nbChunks);
+#endif
+
+#ifdef SPK_MEMORY_STATISTICS
+		// Memory of the group counted in the statistics
+		size_t memorySizes[MEMORY_ALL];
+
+		void updateMemoryStatistics();
+		void setMemorySize(MemoryCategory category,size_t size);
+		void releaseMemoryStatistics();
+#endif
 
 		Group(const Ref<System>& system = SPK_NULL_REF,size_t capacity = 100);
 		Group(const Group& group);
 
-		bool updateParticles(float deltaTime);
+		bool updateParticles(float deltaTime,bool display = true);
 		void renderParticles();
+		void prepareDisplay();
+		void computeDistances();
 
-		bool initParticle(size_t index,size_t& emitterIndex,size_t& nbManualBorn);
-		void swapParticles(size_t index0,size_t index1);
+		void executeUpdateStages(float deltaTime);
+		void executeUpdateStage(const UpdateStage& stage,float deltaTime,size_t start,size_t end,bool chunked);
+		void integrateParticles(float deltaTime,size_t start,size_t end);
+
+		void initParticles(size_t nb,size_t& emitterIndex,size_t& nbManualBorn);
+		void removeDeadParticles();
+		void compactParticles(const size_t* sources,const size_t* destinations,size_t nb);
 
 		void recomputeEnabledParamIndices();
+		size_t getParticleSize() const;
+
+		void growCapacity(size_t nbNeeded);
+		void updateAutoCapacity(float deltaTime);
+		size_t clampAutoCapacity(float capacity) const;
 
 		template<typename T>
 		void reallocateArray(T*& t,size_t newSize,size_t copySize);
 
+		template<typename T>
+		static void compactArray(T* t,const size_t* sources,const size_t* destinations,size_t nb);
+
 		DataSet* attachDataSet(DataHandler* dataHandler);
 		void detachDataSet(DataSet* dataHandler);
 
-		void sortParticles(int start,int end);
+		bool insertionSortParticles(size_t maxShifts);
+		void radixSortParticles();
 		virtual void propagateUpdateTransform();
 
 		void sortParticles();
 		void computeAABB();
 
+		// Visibility
+		float getMaxAcceleration() const;
+		bool feeds(const Group& group) const;
+		size_t acquireBudget(size_t nb) const;
+		void computeParticleBounds(Vector3D& AABBMin,Vector3D& AABBMax) const;
+		void computeEmissionBounds(Vector3D& AABBMin,Vector3D& AABBMax) const;
+		void skipTime(float deltaTime);
+
 		void addParticles(
 			unsigned int nb,
 			const Vector3D& position,
@@ -609,7 +879,9 @@ namespace SPK
 		unsigned int nbBufferedParticles;
 
 		void prepareAdditionnalData();
+		void prepareDataHandler(const DataHandler* dataHandler,DataSet* dataSet);
 		void manageOctreeInstance(bool needsOctree);
+		void manageSpatialIndexInstance(bool needsSpatialIndex);
 
 		void initData();
 	};
@@ -619,16 +891,30 @@ namespace SPK
 		return SPK_NEW(Group,SPK_NULL_REF,capacity);
 	}
 
+#ifdef SPK_PROFILING
+	inline const Stats& Group::getStats() const
+	{
+		return stats;
+	}
+#endif
+
 	template<typename T>
 	void Group::reallocateArray(T*& t,size_t newSize,size_t copySize)
 	{
 		T* oldT = t;
 		t = SPK_NEW_ARRAY(T,newSize);
 		if (oldT != NULL && copySize != 0)
-			std::memcpy(oldT,t,copySize * sizeof(T));
+			std::memcpy(t,oldT,copySize * sizeof(T));
 		SPK_DELETE_ARRAY(oldT);
 	}
 
+	template<typename T>
+	void Group::compactArray(T* t,const size_t* sources,const size_t* destinations,size_t nb)
+	{
+		for (size_t i = 0; i < nb; ++i)
+			t[destinations[i]] = t[sources[i]];
+	}
+
 	inline bool Group::isInitialized() const
 	{
 		return system != NULL && system->isInitialized();
@@ -744,6 +1030,49 @@ namespace SPK
 		return particleData.maxParticles;
 	}
 
+	inline size_t Group::getStorageCapacity() const
+	{
+		return particleData.nbAllocated;
+	}
+
+	inline void Group::enableAutoCapacity(bool autoCapacity)
+	{
+		autoCapacityEnabled = autoCapacity;
+		lowUsageTime = 0.0f;
+		lowUsagePeak = 0;
+	}
+
+	inline bool Group::isAutoCapacityEnabled() const
+	{
+		return autoCapacityEnabled;
+	}
+
+	inline size_t Group::getMinAutoCapacity() const
+	{
+		return minAutoCapacity;
+	}
+
+	inline size_t Group::getMaxAutoCapacity() const
+	{
+		return maxAutoCapacity;
+	}
+
+	inline size_t Group::getHighWaterMark() const
+	{
+		return highWaterMark;
+	}
+
+	inline size_t Group::getNbLostParticles() const
+	{
+		return nbLostParticles;
+	}
+
+	inline void Group::resetCapacityStats()
+	{
+		highWaterMark = particleData.nbParticles;
+		nbLostParticles = 0;
+	}
+
 	inline void Group::empty()
 	{
 		particleData.nbParticles = 0;
@@ -796,6 +1125,28 @@ namespace SPK
 		return sortingEnabled;
 	}
 
+	inline size_t Group::getChunkSize() const
+	{
+		return chunkSize;
+	}
+
+	inline void Group::setRandomSeed(unsigned int seed)
+	{
+		randomGenerator.setSeed(seed);
+	}
+
+	inline RandomGenerator& Group::getRandomGenerator()
+	{
+		return randomGenerator;
+	}
+
+	inline const unsigned int* Group::getSortedIndices() const
+	{
+		if (sortingEnabled && particleData.nbParticles > 0 && sortedIndices.size() == particleData.nbParticles)
+			return &sortedIndices[0];
+		return NULL;
+	}
+
 	inline const void* Group::getColorAddress() const
 	{
 		return particleData.colors;
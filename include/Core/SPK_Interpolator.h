@@ -36,6 +36,25 @@ namespace SPK
 	public :
 		virtual ~Interpolator() {}
 
+		/**
+		* @brief Tells whether this interpolator can interpolate particles by chunks in parallel
+		* @return true if the interpolator is chunk safe, false if not
+		*/
+		bool isChunkSafe() const;
+
+		/**
+		* @brief Gets the bounds of the values this interpolator gives to particles
+		*
+		* This is only meaningful for floats and is used to compute conservative bounds of systems
+		* (see System::computeConservativeAABB(Vector3D&,Vector3D&)).<br>
+		* By default the bounds are unknown.
+		*
+		* @param min : the minimum value
+		* @param max : the maximum value
+		* @return true if the bounds are known, false if not
+		*/
+		virtual bool getBounds(T& min,T& max) const { return false; }
+
 	public :
 		spark_description(Interpolator, SPKObject)
 		(
@@ -45,9 +64,14 @@ namespace SPK
 
 		/**
 		* @brief Constructor of interpolator
+		*
+		* A chunk safe interpolator only reads and writes data of the particle being interpolated (and of its data set at the particle index).<br>
+		* Its particles can then be interpolated by chunks in parallel.
+		*
 		* @param NEEDS_DATASET : true if the interpolator needs additional data, false otherwise
+		* @param CHUNK_SAFE : true if the interpolator is chunk safe, false otherwise
 		*/
-		Interpolator(bool NEEDS_DATASET);
+		Interpolator(bool NEEDS_DATASET,bool CHUNK_SAFE = false);
 
 		/**
 		* @brief A helper method that linearly interpolates a value
@@ -61,6 +85,8 @@ namespace SPK
 		
 	private :
 
+		const bool CHUNK_SAFE;
+
 		/**
 		* @brief Interpolates the given data of the particles of a group
 		* 
@@ -82,17 +108,60 @@ namespace SPK
 		* @param dataset : the associated dataset of the pair interpolator/group. Will be NULL if NEEDS_DATASET is false 
 		*/
 		virtual void init(T& data,Particle& particle,DataSet* dataSet) const = 0;
+
+		/**
+		* @brief Interpolates the given data of the particles of a group within [start,end[
+		*
+		* This is only called on chunk safe interpolators, possibly from several threads at once on distinct chunks.<br>
+		* Chunk safe interpolators must override this method.<br>
+		* The default implementation only reports the missing override, as interpolate(T*,Group&,DataSet*) cannot be restricted to a chunk.
+		*
+		* @param data : the array of data to interpolate
+		* @param group : the group from which to interpolate the data
+		* @param dataSet : the associated dataset of the pair interpolator/group. Will be NULL if NEEDS_DATASET is false
+		* @param start : the index of the first particle of the chunk
+		* @param end : the index after the last particle of the chunk
+		*/
+		virtual void interpolateChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const;
+
+		/**
+		* @brief Initializes the given data of the particles of a group within [start,end[
+		*
+		* This is called once for all the particles born during an update of the group.<br>
+		* The default implementation calls init(T&,Particle&,DataSet*) for each particle.
+		* Interpolators can override it to initialize the data of all the particles in a single loop.
+		*
+		* @param data : the array of data to initialize
+		* @param group : the group of the particles
+		* @param dataSet : the associated dataset of the pair interpolator/group. Will be NULL if NEEDS_DATASET is false
+		* @param start : the index of the first particle to initialize
+		* @param end : the index after the last particle to initialize
+		*/
+		virtual void initChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const;
 	};
 
 	typedef Interpolator<Color> ColorInterpolator; /**< @brief Abstract interpolator of colors */
 	typedef Interpolator<float> FloatInterpolator; /**< @brief Abstract interpolator of floats */
 
 	template<typename T>
-	inline Interpolator<T>::Interpolator(bool NEEDS_DATASET) :
+	inline Interpolator<T>::Interpolator(bool NEEDS_DATASET,bool CHUNK_SAFE) :
 		SPKObject(),
-		DataHandler(NEEDS_DATASET)
+		DataHandler(NEEDS_DATASET),
+		CHUNK_SAFE(CHUNK_SAFE)
 	{}
 
+	template<typename T>
+	inline bool Interpolator<T>::isChunkSafe() const
+	{
+		return CHUNK_SAFE;
+	}
+
+	template<typename T>
+	void Interpolator<T>::interpolateChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const
+	{
+		SPK_ASSERT(false,"Interpolator<T>::interpolateChunk(T*,Group&,DataSet*,size_t,size_t) const - A chunk safe interpolator must override interpolateChunk. The data is not interpolated");
+	}
+
 	template<typename T>
 	inline void Interpolator<T>::interpolateParam(T& result,const T& start,const T& end,float ratio) const
 	{
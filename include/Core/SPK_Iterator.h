@@ -37,6 +37,15 @@ namespace SPK
 		*/
 		Iterator(T& t);
 
+		/**
+		* @brief Constructor of iterator over a range of the collection
+		* The iterator points at start and reaches its end at end
+		* @param t : the collection over which to iterate
+		* @param start : the index of the first particle to iterate over
+		* @param end : the index after the last particle to iterate over
+		*/
+		Iterator(T& t,size_t start,size_t end);
+
 		/**
 		* @brief Gets the particle on which points by the iterator
 		* @return the particle on which points by the iterator
@@ -70,6 +79,7 @@ namespace SPK
 	private :
 
 		mutable Particle particle;
+		size_t endIndex;
 	};
 
 	/** @brief A generic class to iterate over a constant collection of particles */
@@ -85,6 +95,15 @@ namespace SPK
 		*/
 		ConstIterator(const T& t);
 
+		/**
+		* @brief Constructor of iterator over a range of the collection
+		* The iterator points at start and reaches its end at end
+		* @param t : the collection over which to iterate
+		* @param start : the index of the first particle to iterate over
+		* @param end : the index after the last particle to iterate over
+		*/
+		ConstIterator(const T& t,size_t start,size_t end);
+
 		/**
 		* @brief Gets the particle on which points by the iterator
 		* @return the particle on which points by the iterator
@@ -118,10 +137,63 @@ namespace SPK
 	private :
 
 		const Particle particle;
+		size_t endIndex;
 	};
 
-	typedef Iterator<Group> GroupIterator;				/**< @brief Iterator of a Group */
-	typedef ConstIterator<Group> ConstGroupIterator;	/**< @brief Constant Iterator of a Group */
+	/**
+	* @brief A generic class to iterate over a constant collection of particles in their depth order
+	*
+	* When the collection is sorted, particles are iterated from the furthest to the closest from the camera.
+	* Otherwise they are iterated in storage order, like with a ConstIterator.<br>
+	* This is the iterator renderers use to emit particles.
+	*/
+	template<typename T>
+	class ConstSortedIterator
+	{
+	public :
+
+		/**
+		* @brief Constructor of sorted iterator
+		* The iterator points at the furthest particle of the collection
+		* @param t : the collection over which to iterate
+		*/
+		ConstSortedIterator(const T& t);
+
+		/**
+		* @brief Gets the particle on which points by the iterator
+		* @return the particle on which points by the iterator
+		*/
+		const Particle& operator*() const;
+
+		/**
+		* @brief Allows access to the interface of the particle on which points by the iterator
+		* @return the particle on which points by the iterator
+		*/
+		const Particle* operator->() const;
+
+		/**
+		* @brief pre-increments the position of the iterator
+		* @return the incremented iterator
+		*/
+		ConstSortedIterator& operator++();
+
+		/**
+		* @brief Checks whether the iterator has reached the end of the collection
+		* @return true if the iterator has reached the end of the collection, false if not
+		*/
+		bool end() const;
+
+	private :
+
+		const Particle particle;
+		const unsigned int* indices;
+		size_t rank;
+		size_t endRank;
+	};
+
+	typedef Iterator<Group> GroupIterator;							/**< @brief Iterator of a Group */
+	typedef ConstIterator<Group> ConstGroupIterator;				/**< @brief Constant Iterator of a Group */
+	typedef ConstSortedIterator<Group> ConstSortedGroupIterator;	/**< @brief Constant Iterator of a Group in depth order */
 
 	template<typename T>
 	inline bool operator!=(const Iterator<T>& it0,const Iterator<T>& it1) { return it0->getIndex() != it1->getIndex(); }
@@ -134,11 +206,21 @@ namespace SPK
 
 	template<>
 	inline Iterator<Group>::Iterator(Group& group) :
-		particle(group,0)
+		particle(group,0),
+		endIndex(group.getNbParticles())
 	{
 		SPK_ASSERT(group.isInitialized(),"Iterator::Iterator(Group&) - An iterator from an uninitialized group cannot be retrieved");
 	}
 
+	template<>
+	inline Iterator<Group>::Iterator(Group& group,size_t start,size_t end) :
+		particle(group,start),
+		endIndex(end)
+	{
+		SPK_ASSERT(group.isInitialized(),"Iterator::Iterator(Group&,size_t,size_t) - An iterator from an uninitialized group cannot be retrieved");
+		SPK_ASSERT(end <= group.getNbParticles(),"Iterator::Iterator(Group&,size_t,size_t) - The end of the range is out of bounds : " << end);
+	}
+
 	template<>
 	inline Particle& Iterator<Group>::operator*() const
 	{ 
@@ -168,16 +250,26 @@ namespace SPK
 	template<>
 	inline bool Iterator<Group>::end() const
 	{ 
-		return particle.index >= particle.group.getNbParticles();
+		return particle.index >= endIndex;
 	}
 
 	template<>
 	inline ConstIterator<Group>::ConstIterator(const Group& group) :
-		particle(const_cast<Group&>(group),0)
+		particle(const_cast<Group&>(group),0),
+		endIndex(group.getNbParticles())
 	{
 		SPK_ASSERT(group.isInitialized(),"ConstIterator::ConstIterator(Group&) - An const iterator from a uninitialized group cannot be retrieved");	
 	}
 
+	template<>
+	inline ConstIterator<Group>::ConstIterator(const Group& group,size_t start,size_t end) :
+		particle(const_cast<Group&>(group),start),
+		endIndex(end)
+	{
+		SPK_ASSERT(group.isInitialized(),"ConstIterator::ConstIterator(Group&,size_t,size_t) - An const iterator from a uninitialized group cannot be retrieved");
+		SPK_ASSERT(end <= group.getNbParticles(),"ConstIterator::ConstIterator(Group&,size_t,size_t) - The end of the range is out of bounds : " << end);
+	}
+
 	template<>
 	inline const Particle& ConstIterator<Group>::operator*() const
 	{ 
@@ -207,7 +299,45 @@ namespace SPK
 	template<>
 	inline bool ConstIterator<Group>::end() const
 	{ 
-		return particle.index >= particle.group.getNbParticles();
+		return particle.index >= endIndex;
+	}
+
+	template<>
+	inline ConstSortedIterator<Group>::ConstSortedIterator(const Group& group) :
+		particle(const_cast<Group&>(group),0),
+		indices(group.getSortedIndices()),
+		rank(0),
+		endRank(group.getNbParticles())
+	{
+		SPK_ASSERT(group.isInitialized(),"ConstSortedIterator::ConstSortedIterator(Group&) - An const iterator from a uninitialized group cannot be retrieved");
+		if (indices != NULL)
+			particle.index = indices[0];
+	}
+
+	template<>
+	inline const Particle& ConstSortedIterator<Group>::operator*() const
+	{ 
+		return particle;
+	}
+
+	template<>
+	inline const Particle* ConstSortedIterator<Group>::operator->() const 
+	{
+		return &particle;
+	}
+
+	template<>
+	inline ConstSortedIterator<Group>& ConstSortedIterator<Group>::operator++()
+	{
+		if (++rank < endRank)
+			particle.index = indices != NULL ? indices[rank] : rank;
+		return *this;
+	}
+
+	template<>
+	inline bool ConstSortedIterator<Group>::end() const
+	{ 
+		return rank >= endRank;
 	}
 }
 
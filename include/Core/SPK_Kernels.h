@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_KERNELS
+#define H_SPK_KERNELS
+
+/**
+* @file SPK_Kernels.h
+* @brief Vectorized loops over the arrays of particle data
+*
+* The kernels work on plain float streams. Arrays of Vector3D are processed as streams of 3 * nb floats
+* as the coordinates of a Vector3D are contiguous.<br>
+* <br>
+* The instruction set is chosen at compile time : AVX, SSE or NEON when the compiler targets them, a scalar loop otherwise.
+* Defining SPK_NO_SIMD forces the scalar loops.
+* Results are the same whatever the instruction set as only exact operations (addition, multiplication, division) are used.
+*/
+
+namespace SPK
+{
+	/**
+	* @brief Adds a value to each element of an array
+	* @param data : the array
+	* @param value : the value to add
+	* @param nb : the number of elements of the array
+	*/
+	SPK_PREFIX void kernelAdd(float* data,float value,size_t nb);
+
+	/**
+	* @brief Computes the energies of particles
+	* This computes <i>energies[i] = 1.0f - ages[i] / lifeTimes[i]</i>
+	* @param energies : the energies to compute
+	* @param ages : the ages of the particles
+	* @param lifeTimes : the life times of the particles
+	* @param nb : the number of particles
+	*/
+	SPK_PREFIX void kernelComputeEnergies(float* energies,const float* ages,const float* lifeTimes,size_t nb);
+
+	/**
+	* @brief Integrates positions of particles
+	* This computes <i>oldPositions[i] = positions[i]</i> and <i>positions[i] += velocities[i] * deltaTime</i>
+	* @param positions : the positions to integrate
+	* @param oldPositions : the old positions to set
+	* @param velocities : the velocities of the particles
+	* @param deltaTime : the time step
+	* @param nb : the number of floats of the arrays (3 times the number of particles)
+	*/
+	SPK_PREFIX void kernelIntegrate(float* positions,float* oldPositions,const float* velocities,float deltaTime,size_t nb);
+
+	/**
+	* @brief Interpolates linearly between 2 arrays
+	* This computes <i>result[i] = from[i] + (to[i] - from[i]) * ratio</i>
+	* @param result : the array receiving the interpolated values
+	* @param from : the values at ratio 0
+	* @param to : the values at ratio 1
+	* @param ratio : the interpolation ratio
+	* @param nb : the number of elements of the arrays
+	*/
+	SPK_PREFIX void kernelLerp(float* result,const float* from,const float* to,float ratio,size_t nb);
+
+	/**
+	* @brief Computes the square distances between a point and an array of points
+	* This computes <i>sqrDists[i] = dx * dx + dy * dy + dz * dz</i> with <i>dx = x[i] - px</i>, <i>dy = y[i] - py</i> and <i>dz = z[i] - pz</i><br>
+	* The points are given as separate arrays of coordinates so that they can be processed in parallel.
+	* @param sqrDists : the square distances to compute
+	* @param x : the x coordinates of the points
+	* @param y : the y coordinates of the points
+	* @param z : the z coordinates of the points
+	* @param px : the x coordinate of the point to measure the distances from
+	* @param py : the y coordinate of the point to measure the distances from
+	* @param pz : the z coordinate of the point to measure the distances from
+	* @param nb : the number of points
+	*/
+	SPK_PREFIX void kernelSqrDistances(float* sqrDists,const float* x,const float* y,const float* z,float px,float py,float pz,size_t nb);
+
+	/**
+	* @brief Gets the name of the instruction set used by the kernels
+	* @return "AVX", "SSE", "NEON" or "Scalar"
+	*/
+	SPK_PREFIX const char* getKernelInstructionSet();
+}
+
+#endif
@@ -23,6 +23,8 @@
 #define H_SPK_LOGGER
 
 #include <iostream>
+#include <sstream>
+#include <ctime>
 #include <cassert>
 
 /**
@@ -62,6 +64,22 @@
 * @param text : the error entry to log if the assertion fails
 */
 
+/**
+* @def SPK_LOG_MIN_PRIORITY
+* @brief The minimum priority of the entries compiled in
+*
+* The log statements of a lower priority are removed at compile time, whatever the priority level of the logger.<br>
+* The value is an integer matching LogPriority. It can be defined when building SPARK and
+* defaults to 0 (LOG_PRIORITY_DEBUG) in debug and to 1 (LOG_PRIORITY_INFO) otherwise.
+*/
+#ifndef SPK_LOG_MIN_PRIORITY
+#ifdef _DEBUG
+#define SPK_LOG_MIN_PRIORITY 0
+#else
+#define SPK_LOG_MIN_PRIORITY 1
+#endif
+#endif
+
 #ifdef SPK_NO_LOG
 
 #define SPK_LOG_DEBUG(entry) {}
@@ -73,15 +91,46 @@
 
 #else
 
-#ifdef _DEBUG
-#define SPK_LOG_DEBUG(entry) {SPK::Logger::get().getStream(SPK::LOG_PRIORITY_DEBUG) << entry << "\n"; SPK::Logger::get().flush();}
+// The entry is only formatted if it is logged
+#define SPK_LOG(priority,entry) \
+{ \
+	if (SPK::Logger::get().isLogged(priority)) \
+	{ \
+		std::ostringstream spkLogEntry; \
+		spkLogEntry << entry; \
+		SPK::Logger::get().addEntry(priority,spkLogEntry.str()); \
+	} \
+}
+
+#if SPK_LOG_MIN_PRIORITY <= 0
+#define SPK_LOG_DEBUG(entry) SPK_LOG(SPK::LOG_PRIORITY_DEBUG,entry)
 #else
 #define SPK_LOG_DEBUG(entry) {}
 #endif
-#define SPK_LOG_INFO(entry) {SPK::Logger::get().getStream(SPK::LOG_PRIORITY_INFO) << entry << "\n"; SPK::Logger::get().flush();}
-#define SPK_LOG_WARNING(entry) {SPK::Logger::get().getStream(SPK::LOG_PRIORITY_WARNING) << entry << "\n"; SPK::Logger::get().flush();}
-#define SPK_LOG_ERROR(entry) {SPK::Logger::get().getStream(SPK::LOG_PRIORITY_ERROR) << entry << "\n"; SPK::Logger::get().flush();}
-#define SPK_LOG_FATAL(entry) {SPK::Logger::get().getStream(SPK::LOG_PRIORITY_FATAL) << entry << "\n"; SPK::Logger::get().flush();}
+
+#if SPK_LOG_MIN_PRIORITY <= 1
+#define SPK_LOG_INFO(entry) SPK_LOG(SPK::LOG_PRIORITY_INFO,entry)
+#else
+#define SPK_LOG_INFO(entry) {}
+#endif
+
+#if SPK_LOG_MIN_PRIORITY <= 2
+#define SPK_LOG_WARNING(entry) SPK_LOG(SPK::LOG_PRIORITY_WARNING,entry)
+#else
+#define SPK_LOG_WARNING(entry) {}
+#endif
+
+#if SPK_LOG_MIN_PRIORITY <= 3
+#define SPK_LOG_ERROR(entry) SPK_LOG(SPK::LOG_PRIORITY_ERROR,entry)
+#else
+#define SPK_LOG_ERROR(entry) {}
+#endif
+
+#if SPK_LOG_MIN_PRIORITY <= 4
+#define SPK_LOG_FATAL(entry) SPK_LOG(SPK::LOG_PRIORITY_FATAL,entry)
+#else
+#define SPK_LOG_FATAL(entry) {}
+#endif
 
 #define SPK_ASSERT(condition,text) \
 { \
@@ -126,10 +175,12 @@ namespace SPK
 	* <li>SPK_LOG_ERROR(entry) : to log an error which will most likely result to an immediate crash</li>
 	* <li>SPK_LOG_FATAL(entry) : to log an fatal error due to an engine inconsistency. This must only be used by the engine</li>
 	* </ul>
-	* Those macros are shortcuts to a call to the logger. Moreover they flush the inner stream so that the entry is logged instantly.<br>
+	* Those macros are shortcuts to a call to addEntry(LogPriority,const std::string&). The entry is only formatted if its priority is logged
+	* and the macros of a priority lower than SPK_LOG_MIN_PRIORITY are removed at compile time.<br>
 	* Some access to lower level methods are possible to be able to log message in a more precise way (getStream,flush...).<br>
 	* <br>
-	* 
+	* The logger can be made asynchronous (see setAsynchronous(bool)). Entries are then stored in a lock free ring buffer
+	* and written to the inner stream by a background thread, so that logging never blocks the calling thread.
 	*/
 	class SPK_PREFIX Logger
 	{
@@ -192,6 +243,24 @@ namespace SPK
 		*/
 		void setPrefixFlag(int prefixFlag);
 
+		/**
+		* @brief Enables or disables the asynchronous logging
+		*
+		* When asynchronous, the entries added with addEntry(LogPriority,const std::string&) (and thus the macros) are copied into a ring buffer
+		* and written to the inner stream by a background thread. The prefix is then written by the background thread as well.<br>
+		* Entries longer than MAX_ASYNC_ENTRY_LENGTH characters are truncated.
+		* When the ring buffer is full, entries are dropped rather than waited for and the number of dropped entries is logged afterwards.<br>
+		* <br>
+		* While the logger is asynchronous, the stream returned by getStream(LogPriority,bool) must not be used
+		* and the inner stream and prefix flag must not be changed.<br>
+		* Disabling the asynchronous logging writes all the pending entries and stops the background thread.<br>
+		* <br>
+		* When SPARK is built with SPK_NO_THREADS defined, the logger always stays synchronous.
+		*
+		* @param async : true to make the logger asynchronous, false to make it synchronous
+		*/
+		void setAsynchronous(bool async);
+
 		/////////////
 		// Getters //
 		/////////////
@@ -208,6 +277,19 @@ namespace SPK
 		*/
 		LogPriority getPriorityLevel() const;
 
+		/**
+		* @brief Tells whether entries of the given priority are logged
+		* @param priority : the priority of the entries
+		* @return true if the logger is enabled and the priority is not lower than the priority level, false otherwise
+		*/
+		bool isLogged(LogPriority priority) const;
+
+		/**
+		* @brief Tells whether the logger is asynchronous
+		* @return true if the logger is asynchronous, false if not
+		*/
+		bool isAsynchronous() const;
+
 		/**
 		* @brief Gets the stream of the logger
 		*
@@ -236,14 +318,19 @@ namespace SPK
 		* @brief Logs in an entry to the logger
 		* 
 		* The entry is prefixed with the prefix, a new line instruction is called at the end
-		* and the logger is then flushed.
+		* and the logger is then flushed.<br>
+		* If the logger is asynchronous, the entry is only queued to be written by the background thread.
 		*
 		* @param priority : the priority level of the entry
 		* @param entry : the entry to log in
 		*/
 		void addEntry(LogPriority priority,const std::string& entry);
 
-		/** @brief Flushes the logger (Immediately appends pending entries to the inner stream) */
+		/**
+		* @brief Flushes the logger (Immediately appends pending entries to the inner stream)
+		*
+		* If the logger is asynchronous, this waits until the background thread has written the entries queued so far.
+		*/
 		void flush();
 
 		//////////////////
@@ -267,26 +354,36 @@ namespace SPK
 			LogPriority priority;
 		};
 
+		/** @brief The maximum length of an entry logged asynchronously */
+		static const size_t MAX_ASYNC_ENTRY_LENGTH = 256;
+
 	private :
 
+		struct AsyncBackend;
+
 		static Logger* instance; // The unique instance of Logger
 
 		static const size_t NB_PRIORITY_LEVELS = 5; // Number of priority levels
 		static const std::string PRIORITY_NAMES[NB_PRIORITY_LEVELS]; // Names of priority levels
+		static const size_t MAX_TIME_PREFIX_LENGTH = 64; // Size of the buffer of the formatted date and time
 
 		std::ostream* innerStream;
 		LogPriority priorityLevel;
 		int prefixFlag;
 		bool enabled;
 
+		AsyncBackend* asyncBackend;
+
 		// private constructor and destructor (singleton pattern)
 		Logger();
-		~Logger(){}
+		~Logger();
 
 		Logger(const Logger&); // Not used
 		Logger& operator=(const Logger&); // Not used
 
 		void writePrefix(LogPriority priority);
+		void writePrefix(LogPriority priority,time_t time);
+		void writeEntry(LogPriority priority,time_t time,const char* entry,size_t length);
 	};
 
 	inline void Logger::setEnabled(bool enabled)
@@ -323,22 +420,21 @@ namespace SPK
 	{
 		return prefixFlag;
 	}
-	
-	inline void Logger::addEntry(LogPriority priority,const std::string& entry)
+
+	inline bool Logger::isLogged(LogPriority priority) const
 	{
-		getStream(priority) << entry.c_str() << "\n";
-		flush();
+		return enabled && priority >= priorityLevel;
 	}
 
-	inline void Logger::flush()
+	inline bool Logger::isAsynchronous() const
 	{
-		if (isEnabled()) innerStream->flush();
+		return asyncBackend != NULL;
 	}
 
 	template <typename T> 
 	Logger::Stream& Logger::Stream::operator<<(const T& entry)
 	{
-		if (Logger::get().isEnabled() && priority >= Logger::get().getPriorityLevel())
+		if (Logger::get().isLogged(priority))
 			innerStream << entry;
 		return *this;
 	}
@@ -110,4 +110,106 @@ namespace SPK
 	}
 }
 #endif
+
+#ifdef SPK_MEMORY_STATISTICS
+
+#ifndef SPK_NO_THREADS
+#include <atomic>
+#endif
+
+namespace SPK
+{
+	/**
+	* @brief Constants defining the categories of memory counted by MemoryStatistics
+	*/
+	enum MemoryCategory
+	{
+		MEMORY_PARTICLES,		/**< The arrays holding the particles of the groups */
+		MEMORY_DATASETS,		/**< The additional data of the groups */
+		MEMORY_RENDER_BUFFERS,	/**< The buffers of the renderers */
+		MEMORY_OCTREE,			/**< The octrees and spatial indices of the groups */
+		MEMORY_IO,				/**< The buffers used to load and save */
+		MEMORY_ALL,				/**< All the categories together */
+	};
+
+	/**
+	* @brief Counters of the current and peak memory used by SPARK, per category
+	*
+	* Unlike SPKMemoryTracer, the statistics only keep a few counters and do not record the allocations themselves.
+	* They are cheap enough to be enabled in release builds, by defining SPK_MEMORY_STATISTICS when building SPARK (this requires a C++11 compiler).<br>
+	* <br>
+	* The global statistics count all the memory of SPARK. Each System also holds its own statistics, counting the memory of its groups.
+	* The memory of the groups is counted at the end of their update, the peaks are therefore measured at the frame granularity.<br>
+	* <br>
+	* Counters are atomic so they can be updated and read from several threads
+	* (unless SPARK is built with SPK_NO_THREADS defined).
+	*/
+	class SPK_PREFIX MemoryStatistics
+	{
+	public :
+
+		MemoryStatistics();
+
+		/**
+		* @brief Gets the global memory statistics of SPARK
+		* @return the global memory statistics
+		*/
+		static MemoryStatistics& get();
+
+		/**
+		* @brief Counts an allocation
+		* @param category : the category of the allocated memory
+		* @param size : the size in bytes of the allocation
+		*/
+		void allocate(MemoryCategory category,size_t size);
+
+		/**
+		* @brief Counts a deallocation
+		* @param category : the category of the deallocated memory
+		* @param size : the size in bytes of the deallocation
+		*/
+		void deallocate(MemoryCategory category,size_t size);
+
+		/**
+		* @brief Gets the memory currently used in a category
+		* @param category : the category
+		* @return the size in bytes currently used
+		*/
+		size_t getSize(MemoryCategory category = MEMORY_ALL) const;
+
+		/**
+		* @brief Gets the maximum memory used in a category since the creation or the last reset of the peaks
+		* @param category : the category
+		* @return the maximum size in bytes used
+		*/
+		size_t getPeakSize(MemoryCategory category = MEMORY_ALL) const;
+
+		/** @brief Resets the peaks of all the categories to the memory currently used */
+		void resetPeakSizes();
+
+	private :
+
+#ifdef SPK_NO_THREADS
+		typedef size_t Counter;
+#else
+		typedef std::atomic<size_t> Counter;
+#endif
+
+		Counter sizes[MEMORY_ALL + 1];
+		Counter peakSizes[MEMORY_ALL + 1];
+
+		MemoryStatistics(const MemoryStatistics&); // Not used
+		MemoryStatistics& operator=(const MemoryStatistics&); // Not used
+
+		void add(size_t index,size_t size);
+	};
+}
+
+#define SPK_TRACK_MEMORY(category,size) SPK::MemoryStatistics::get().allocate(category,size)
+#define SPK_UNTRACK_MEMORY(category,size) SPK::MemoryStatistics::get().deallocate(category,size)
+#else
+#define SPK_TRACK_MEMORY(category,size) {}
+#define SPK_UNTRACK_MEMORY(category,size) {}
+#endif
+
 #endif
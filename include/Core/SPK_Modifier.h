@@ -22,6 +22,8 @@
 #ifndef H_SPK_MODIFIER
 #define H_SPK_MODIFIER
 
+#include <limits>
+
 namespace SPK
 {
 	class Particle;
@@ -40,7 +42,12 @@ namespace SPK
 	/**
 	* @brief An abstract class that allows to modify the behaviour of a group of particles over time
 	*
-	* 
+	* A modifier can declare itself chunk safe, meaning its modification of a particle only reads and writes data of that particle
+	* (and of its data set at the particle index).<br>
+	* The particles of a chunk safe modifier can be modified by chunks in parallel when the system of the group has a TaskManager.
+	* In that case, modifyChunk(Group&,DataSet*,float,size_t,size_t) is called instead of modify(Group&,DataSet*,float).<br>
+	* <br>
+	* A modifier needing to know the neighbors of particles can request an Octree or a SpatialIndex from its group.
 	*/
 	class Modifier : public Transformable, public DataHandler
 	{
@@ -74,6 +81,46 @@ namespace SPK
 		*/
 		unsigned int getPriority() const;
 
+		/**
+		* @brief Tells whether this modifier can modify particles by chunks in parallel
+		* @return true if the modifier is chunk safe, false if not
+		*/
+		bool isChunkSafe() const;
+
+		/**
+		* @brief Gets an upper bound of the acceleration this modifier gives to the particles of a group
+		*
+		* This is used to compute conservative bounds of systems (see System::computeConservativeAABB(Vector3D&,Vector3D&)).<br>
+		* By default the acceleration is unbounded, which makes the bounds of the group cover the whole space.
+		* Modifiers which never increase the speed of particles return 0.
+		*
+		* @param group : the group of the particles
+		* @return the maximum acceleration or infinity if it cannot be bounded
+		*/
+		virtual float getMaxAcceleration(const Group& group) const { return std::numeric_limits<float>::infinity(); }
+
+		/**
+		* @brief Tells whether this modifier can be shared by the instances of a SystemPool
+		*
+		* A modifier referencing objects owned by a system (a group for instance) must not be shared,
+		* as the instances would then reference the objects of the prototype instead of their own copies.<br>
+		* By default a modifier can be shared.
+		*
+		* @return true if the modifier can be shared, false if not
+		*/
+		virtual bool isShareable() const { return true; }
+
+		/**
+		* @brief Tells whether this modifier adds particles to a group
+		*
+		* This is used to know how long the particles of a group can live after the death of the particles of the groups feeding it
+		* (see System::prewarm(float,float)). By default a modifier does not add particles.
+		*
+		* @param group : the group
+		* @return true if the modifier may add particles to the group, false if not
+		*/
+		virtual bool spawnsInto(const Group& group) const { return false; }
+
 	public :
 		spark_description(Modifier, Transformable)
 		(
@@ -83,26 +130,58 @@ namespace SPK
 
 	protected :
 
-		Modifier(unsigned int PRIORITY,bool NEEDS_DATASET,bool CALL_INIT,bool NEEDS_OCTREE);
+		Modifier(unsigned int PRIORITY,bool NEEDS_DATASET,bool CALL_INIT,bool NEEDS_OCTREE,bool CHUNK_SAFE = false,bool NEEDS_SPATIAL_INDEX = false);
 
 	private :
 
 		const unsigned int PRIORITY;
 		const bool CALL_INIT;
 		const bool NEEDS_OCTREE;
+		const bool CHUNK_SAFE;
+		const bool NEEDS_SPATIAL_INDEX;
 		
 		bool active;
 		bool local;
 
 		virtual void init(Particle& particle,DataSet* dataSet) const {};
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const = 0;
+
+		/**
+		* @brief Initializes the particles of a group within [start,end[
+		*
+		* This is called once for all the particles born during an update of the group, if CALL_INIT is true.<br>
+		* The default implementation calls init(Particle&,DataSet*) for each particle.
+		*
+		* @param group : the group of the particles
+		* @param dataSet : the data set of the pair modifier/group
+		* @param start : the index of the first particle to initialize
+		* @param end : the index after the last particle to initialize
+		*/
+		virtual void initChunk(Group& group,DataSet* dataSet,size_t start,size_t end) const;
+
+		/**
+		* @brief Modifies the particles of a group within [start,end[
+		*
+		* This is only called on chunk safe modifiers, possibly from several threads at once on distinct chunks.<br>
+		* Chunk safe modifiers must override this method. modify(Group&,DataSet*,float) typically calls it with the whole range of particles.<br>
+		* The default implementation only reports the missing override, as modify(Group&,DataSet*,float) cannot be restricted to a chunk.
+		*
+		* @param group : the group of particles to modify
+		* @param dataSet : the data set of the pair modifier/group
+		* @param deltaTime : the time step
+		* @param start : the index of the first particle of the chunk
+		* @param end : the index after the last particle of the chunk
+		*/
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
-	inline Modifier::Modifier(unsigned int PRIORITY,bool NEEDS_DATASET,bool CALL_INIT,bool NEEDS_OCTREE) :
+	inline Modifier::Modifier(unsigned int PRIORITY,bool NEEDS_DATASET,bool CALL_INIT,bool NEEDS_OCTREE,bool CHUNK_SAFE,bool NEEDS_SPATIAL_INDEX) :
 		DataHandler(NEEDS_DATASET),
 		PRIORITY(PRIORITY),
 		CALL_INIT(CALL_INIT),
 		NEEDS_OCTREE(NEEDS_OCTREE),
+		CHUNK_SAFE(CHUNK_SAFE),
+		NEEDS_SPATIAL_INDEX(NEEDS_SPATIAL_INDEX),
 		active(true),
 		local(false)
 	{}
@@ -131,6 +210,11 @@ namespace SPK
 	{
 		return PRIORITY;
 	}
+
+	inline bool Modifier::isChunkSafe() const
+	{
+		return CHUNK_SAFE;
+	}
 }
 
 #endif
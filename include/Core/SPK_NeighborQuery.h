@@ -0,0 +1,223 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef H_SPK_NEIGHBORQUERY
+#define H_SPK_NEIGHBORQUERY
+
+#include <algorithm>
+#include <vector>
+
+namespace SPK
+{
+	class SpatialIndex;
+
+	/**
+	* @brief Queries of the neighbors of particles within the SpatialIndex of a group
+	*
+	* A query visits the particles closer than a radius to a position or to a particle and calls a kernel for each of them.
+	* The kernel is a template parameter so that its call is inlined within the loop over the neighbors.<br>
+	* The candidates given by the spatial index are tested against the radius in SIMD over packed arrays of coordinates (see kernelSqrDistances()).<br>
+	* <br>
+	* The kernel of a query around a position implements <i>void operator()(size_t index,const Vector3D& offset,float sqrDist)</i>.<br>
+	* The kernel of a query around a particle or over the pairs implements <i>void operator()(size_t index0,size_t index1,const Vector3D& offset,float sqrDist)</i>.<br>
+	* The offset is the queried position (or the position of the particle index0) minus the position of the neighbor and sqrDist is its square norm.
+	* Neighbors are visited in the order of the spatial index, which does not depend on the number of threads.<br>
+	* <br>
+	* forEachPair(float,const Kernel&) visits all the pairs of particles closer than a radius, in parallel when the system of the group has a TaskManager.
+	* Each pair is visited twice, once from each of its particles, and the jobs split the particles of the group by the first particle of the pairs.
+	* Therefore a kernel can write the data of the particle index0 without synchronization but must not write anything else.<br>
+	* <br>
+	* The group must have a spatial index, which means that one of its modifiers sets NEEDS_SPATIAL_INDEX to true.
+	* Queries are meant to be made from Modifier::modify(Group&,DataSet*,float) const, once the spatial index is updated.
+	* A particle moved since then may be missed by the queries.<br>
+	* <br>
+	* Here is how a modifier can compute the densities of the particles as a simple SPH would :
+	* @code
+	*	struct DensityKernel
+	*	{
+	*		float* densities;
+	*		float sqrRadius;
+	*
+	*		void operator()(size_t index0,size_t index1,const Vector3D& offset,float sqrDist) const
+	*		{
+	*			float weight = sqrRadius - sqrDist;
+	*			densities[index0] += weight * weight * weight;
+	*		}
+	*	};
+	*
+	*	void Density::modify(Group& group,DataSet* dataSet,float deltaTime) const
+	*	{
+	*		float* densities = SPK_GET_DATA(FloatArrayData,dataSet,DENSITY_INDEX).getData();
+	*		std::fill(densities,densities + group.getNbParticles(),0.0f);
+	*
+	*		DensityKernel kernel = { densities,radius * radius };
+	*		NeighborQuery(group).forEachPair(radius,kernel);
+	*	}
+	* @endcode
+	*/
+	class SPK_PREFIX NeighborQuery
+	{
+	public :
+
+		/**
+		* @brief Constructor of neighbor query
+		* @param group : the group whose particles are queried, it must have a spatial index
+		*/
+		NeighborQuery(Group& group);
+
+		/////////////
+		// Queries //
+		/////////////
+
+		/**
+		* @brief Visits the particles closer than a radius to a position
+		* @param position : the position
+		* @param radius : the radius
+		* @param kernel : the kernel called for each particle
+		*/
+		template<typename Kernel>
+		void forEachNeighbor(const Vector3D& position,float radius,Kernel& kernel);
+
+		/**
+		* @brief Visits the particles closer than a radius to a particle
+		*
+		* The particle itself is not visited.
+		*
+		* @param index : the index of the particle
+		* @param radius : the radius
+		* @param kernel : the kernel called for each neighbor
+		*/
+		template<typename Kernel>
+		void forEachNeighbor(size_t index,float radius,Kernel& kernel);
+
+		/**
+		* @brief Visits all the pairs of particles closer than a radius
+		*
+		* The pairs are visited in parallel when the system of the group has a TaskManager.
+		* See the class description for the constraints on the kernel.
+		*
+		* @param radius : the radius
+		* @param kernel : the kernel called for each pair, from each of its particles
+		*/
+		template<typename Kernel>
+		void forEachPair(float radius,const Kernel& kernel) const;
+
+	private :
+
+		template<typename Kernel> class PairTask;
+
+		// The neighbors found by a query, packed so that their distances are computed in SIMD
+		struct Neighbors
+		{
+			std::vector<size_t> buckets;
+			std::vector<unsigned int> indices;
+			std::vector<float> x;
+			std::vector<float> y;
+			std::vector<float> z;
+			std::vector<float> sqrDists;
+		};
+
+		static const size_t NO_INDEX = static_cast<size_t>(-1);
+		static const size_t PAIR_JOB_SIZE = 1024;
+
+		Group& group;
+		const SpatialIndex* spatialIndex;
+
+		Neighbors neighbors; // Used by the queries from the calling thread
+
+		void findNeighbors(const Vector3D& position,float radius,size_t excludedIndex,Neighbors& neighbors) const;
+
+		template<typename Kernel>
+		void visitNeighbors(size_t index,float radius,Kernel& kernel,Neighbors& neighbors) const;
+	};
+
+	template<typename Kernel>
+	class NeighborQuery::PairTask : public Task
+	{
+	public :
+
+		PairTask(const NeighborQuery& query,float radius,const Kernel& kernel) :
+			query(query),
+			radius(radius),
+			kernel(kernel)
+		{}
+
+		virtual void execute(size_t jobIndex)
+		{
+			const size_t start = jobIndex * PAIR_JOB_SIZE;
+			const size_t end = std::min(start + PAIR_JOB_SIZE,query.group.getNbParticles());
+
+			Neighbors neighbors; // Each job has its own buffers
+			for (size_t i = start; i < end; ++i)
+				query.visitNeighbors(i,radius,kernel,neighbors);
+		}
+
+	private :
+
+		const NeighborQuery& query;
+		const float radius;
+		const Kernel& kernel;
+	};
+
+	template<typename Kernel>
+	void NeighborQuery::forEachNeighbor(const Vector3D& position,float radius,Kernel& kernel)
+	{
+		findNeighbors(position,radius,NO_INDEX,neighbors);
+
+		const size_t nbNeighbors = neighbors.indices.size();
+		for (size_t i = 0; i < nbNeighbors; ++i)
+			kernel(neighbors.indices[i],Vector3D(position.x - neighbors.x[i],position.y - neighbors.y[i],position.z - neighbors.z[i]),neighbors.sqrDists[i]);
+	}
+
+	template<typename Kernel>
+	inline void NeighborQuery::forEachNeighbor(size_t index,float radius,Kernel& kernel)
+	{
+		visitNeighbors(index,radius,kernel,neighbors);
+	}
+
+	template<typename Kernel>
+	void NeighborQuery::forEachPair(float radius,const Kernel& kernel) const
+	{
+		const size_t nbJobs = (group.getNbParticles() + PAIR_JOB_SIZE - 1) / PAIR_JOB_SIZE;
+		TaskManager* taskManager = group.getTaskManager();
+
+		PairTask<Kernel> task(*this,radius,kernel);
+		if (taskManager != NULL && nbJobs > 1)
+			taskManager->execute(task,nbJobs);
+		else
+			for (size_t i = 0; i < nbJobs; ++i)
+				task.execute(i);
+	}
+
+	template<typename Kernel>
+	void NeighborQuery::visitNeighbors(size_t index,float radius,Kernel& kernel,Neighbors& neighbors) const
+	{
+		const Vector3D position = group.getParticle(index).position();
+		findNeighbors(position,radius,index,neighbors);
+
+		const size_t nbNeighbors = neighbors.indices.size();
+		for (size_t i = 0; i < nbNeighbors; ++i)
+			kernel(index,neighbors.indices[i],Vector3D(position.x - neighbors.x[i],position.y - neighbors.y[i],position.z - neighbors.z[i]),neighbors.sqrDists[i]);
+	}
+}
+
+#endif
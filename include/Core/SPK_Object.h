@@ -132,7 +132,7 @@ namespace SPK
 
 		std::string name;
 
-		unsigned int nbReferences;
+		ReferenceCounter nbReferences;
 
 		const SharePolicy SHARE_POLICY;
 		bool shared;
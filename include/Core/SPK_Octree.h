@@ -217,6 +217,12 @@ namespace SPK
 		*/
 		const Vector3D& getAABBMax() const { return AABBMax; }
 
+		/**
+		* @brief Gets the size in bytes of the memory allocated by the octree
+		* @return the size in bytes of the memory allocated by the octree
+		*/
+		size_t getMemorySize() const;
+
 		// TODO Allows to tweak the octree param
 
 	private :
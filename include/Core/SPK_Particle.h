@@ -43,6 +43,8 @@ namespace SPK
 	friend class Iterator;
 	template<typename T>
 	friend class ConstIterator;
+	template<typename T>
+	friend class ConstSortedIterator;
 
 	public :
 
@@ -347,6 +349,17 @@ namespace SPK
 		group.particleData.energies[index] = 0.0f;
 		group.particleData.ages[index] = group.particleData.lifeTimes[index];
 	}
+
+	// Defined here as the definition of Particle is needed
+	template<typename T>
+	void Interpolator<T>::initChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const
+	{
+		for (size_t i = start; i < end; ++i)
+		{
+			Particle particle = group.getParticle(i);
+			init(data[i],particle,dataSet);
+		}
+	}
 }
 
 #endif
@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_RANDOMGENERATOR
+#define H_SPK_RANDOMGENERATOR
+
+namespace SPK
+{
+	/**
+	* @brief A fast seedable generator of pseudo random numbers
+	*
+	* The generator implements xoshiro128+ which has a 128 bits state and a period of 2^128 - 1.<br>
+	* A same seed always gives the same sequence of numbers, which allows deterministic replays.<br>
+	* <br>
+	* A generator is not thread safe. Each group owns its generator which is used for all the random draws (SPK_RANDOM)
+	* made during its update, so that groups can be updated on different threads.
+	*/
+	class RandomGenerator
+	{
+	public :
+
+		/**
+		* @brief Constructor of random generator
+		* @param seed : the seed of the generator
+		*/
+		RandomGenerator(unsigned int seed = 1);
+
+		/**
+		* @brief Seeds the generator
+		* @param seed : the seed of the generator
+		*/
+		void setSeed(unsigned int seed);
+
+		/**
+		* @brief Generates a random 32 bits integer
+		* @return a random integer
+		*/
+		unsigned int next();
+
+		/**
+		* @brief Generates a random float within [0,1[
+		* @return a random float within [0,1[
+		*/
+		float generateFloat();
+
+		/**
+		* @brief Generates a random value within the interval [min,max[
+		* @param min : the minimum bound of the interval (inclusive)
+		* @param max : the maximum bound of the interval (exclusive)
+		* @return a random value within [min,max[
+		*/
+		template<typename T>
+		T generate(const T& min,const T& max);
+
+		/**
+		* @brief Fills an array with random floats within the interval [min,max[
+		*
+		* This is faster than generating the values one by one as the state of the generator stays in registers.
+		*
+		* @param values : the array to fill
+		* @param nb : the number of values to generate
+		* @param min : the minimum bound of the interval (inclusive)
+		* @param max : the maximum bound of the interval (exclusive)
+		*/
+		void fill(float* values,size_t nb,float min,float max);
+
+	private :
+
+		unsigned int state[4];
+
+		static unsigned int rotateLeft(unsigned int x,int k);
+		static float toFloat(unsigned int x);
+	};
+
+	inline RandomGenerator::RandomGenerator(unsigned int seed)
+	{
+		setSeed(seed);
+	}
+
+	inline void RandomGenerator::setSeed(unsigned int seed)
+	{
+		// The state is expanded from the seed with splitmix32 so that close seeds give uncorrelated sequences
+		for (size_t i = 0; i < 4; ++i)
+		{
+			unsigned int z = (seed += 0x9E3779B9u);
+			z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+			z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+			state[i] = z ^ (z >> 16);
+		}
+
+		if ((state[0] | state[1] | state[2] | state[3]) == 0) // The state must not be 0
+			state[0] = 1;
+	}
+
+	inline unsigned int RandomGenerator::rotateLeft(unsigned int x,int k)
+	{
+		return (x << k) | (x >> (32 - k));
+	}
+
+	inline float RandomGenerator::toFloat(unsigned int x)
+	{
+		// The 24 upper bits are used as the lower bits of xoshiro128+ are weak
+		return (x >> 8) * (1.0f / 16777216.0f);
+	}
+
+	inline unsigned int RandomGenerator::next()
+	{
+		const unsigned int result = state[0] + state[3];
+		const unsigned int t = state[1] << 9;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotateLeft(state[3],11);
+
+		return result;
+	}
+
+	inline float RandomGenerator::generateFloat()
+	{
+		return toFloat(next());
+	}
+
+	template<typename T>
+	inline T RandomGenerator::generate(const T& min,const T& max)
+	{
+		return static_cast<T>(min + ((next() >> 1) / 2147483648.0) * (max - min));
+	}
+
+	template<>
+	inline float RandomGenerator::generate(const float& min,const float& max)
+	{
+		return min + generateFloat() * (max - min);
+	}
+
+	inline void RandomGenerator::fill(float* values,size_t nb,float min,float max)
+	{
+		unsigned int s0 = state[0];
+		unsigned int s1 = state[1];
+		unsigned int s2 = state[2];
+		unsigned int s3 = state[3];
+		const float range = max - min;
+
+		for (size_t i = 0; i < nb; ++i)
+		{
+			const unsigned int result = s0 + s3;
+			const unsigned int t = s1 << 9;
+
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= t;
+			s3 = rotateLeft(s3,11);
+
+			values[i] = min + toFloat(result) * range;
+		}
+
+		state[0] = s0;
+		state[1] = s1;
+		state[2] = s2;
+		state[3] = s3;
+	}
+}
+
+#endif
@@ -23,6 +23,12 @@
 #define H_SPK_REFERENCE
 
 #include <iostream> // for operator <<
+#ifdef SPK_MOVE_SEMANTICS
+#include <utility> // for std::move
+#endif
+#ifdef SPK_ATOMIC_REFERENCES
+#include <atomic>
+#endif
 
 #define SPK_NULL_REF SPK::NullReferenceValue()
 
@@ -31,6 +37,12 @@ namespace SPK
 	// Hack to allow easy null reference initialization
 	class NullReferenceValue {};
 
+#ifdef SPK_ATOMIC_REFERENCES
+	typedef std::atomic<unsigned int> ReferenceCounter;
+#else
+	typedef unsigned int ReferenceCounter;
+#endif
+
 	/**
 	* @brief A strong reference on a SPKObject
 	*
@@ -41,11 +53,15 @@ namespace SPK
 	* Moreover implicit conversions exists between Ref and standard pointer.<br>
 	* Implicit downcasting is also implemented. Upcasting can be performed with a call to cast<T> (equivalent to dynamic_cast<T>)<br>
 	* <br>
-	* In practice, An SPKObject must always be manipulated through a reference.
+	* In practice, An SPKObject must always be manipulated through a reference.<br>
+	* <br>
+	* The reference counting is only thread safe when SPARK is built with SPK_ATOMIC_REFERENCES defined.
+	* When the compiler supports it, a Ref can be moved, which transfers the reference without changing the reference count.
 	*/
 	template<typename T>
 	class Ref
 	{
+	template<typename U> friend class Ref;
 	template<typename U> friend void swap(Ref<U>&,Ref<U>&);
 
 	public :
@@ -64,6 +80,13 @@ namespace SPK
 		template<typename U> Ref(const Ref<U>& ref) :
 			ptr(ref.get()) { increment(); }
 
+#ifdef SPK_MOVE_SEMANTICS
+		Ref(Ref&& ref) :
+			ptr(ref.ptr) { ref.ptr = NULL; }
+		template<typename U> Ref(Ref<U>&& ref) :
+			ptr(ref.ptr) { ref.ptr = NULL; }
+#endif
+
 		~Ref() { decrement(); }
 
 		//////////////////////////
@@ -112,6 +135,23 @@ namespace SPK
 			return *this;
 		}
 
+#ifdef SPK_MOVE_SEMANTICS
+		Ref& operator=(Ref&& ref)
+		{
+			// The previous reference is released through the temporary once the move is done
+			Ref tmp(std::move(ref));
+			swap(*this,tmp);
+			return *this;
+		}
+
+		template<typename U> Ref& operator=(Ref<U>&& ref)
+		{
+			Ref tmp(std::move(ref));
+			swap(*this,tmp);
+			return *this;
+		}
+#endif
+
 		T& operator*() const { return *ptr; }
 		T* operator->() const { return ptr; }
 		T* get() const { return ptr; }
@@ -123,9 +163,15 @@ namespace SPK
 
 	private :
 
-		// TODO In order to be thread safe, nbReferences must be volatile and increment/decrement must be atomic
+#ifdef SPK_ATOMIC_REFERENCES
+		// A new reference is always taken from an existing one so no ordering is needed on increment
+		// The release on decrement and the acquire before deletion ensure all accesses happen before the destruction
+		void increment() { if (ptr != NULL) ptr->nbReferences.fetch_add(1,std::memory_order_relaxed); }
+		void decrement() { if (ptr != NULL && ptr->nbReferences.fetch_sub(1,std::memory_order_acq_rel) == 1) SPK_DELETE(ptr); }
+#else
 		void increment() { if (ptr != NULL) ++(ptr->nbReferences); }
 		void decrement() { if (ptr != NULL && --(ptr->nbReferences) == 0) SPK_DELETE(ptr); }
+#endif
 
 		T* ptr;
 	};
@@ -30,6 +30,16 @@ namespace SPK
 
 		virtual  ~RenderBuffer() {}
 
+		/**
+		* @brief Gets the size in bytes of the memory allocated by the buffer
+		*
+		* This is used to count the memory of the render buffers (see MemoryStatistics).
+		* The default implementation returns 0.
+		*
+		* @return the size in bytes of the memory allocated by the buffer
+		*/
+		virtual size_t getMemorySize() const { return 0; }
+
 	protected :
 
 		RenderBuffer() {} // abstract class
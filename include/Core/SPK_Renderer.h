@@ -136,6 +136,19 @@ namespace SPK
 		virtual  RenderBuffer* attachRenderBuffer(const Group& group) const;
 
 		virtual  void init(const Particle& particle,DataSet* dataSet) const {};
+
+		/**
+		* @brief Initializes the renderer data of the particles of a group within [start,end[
+		*
+		* This is called once for all the particles born during an update of the group.<br>
+		* The default implementation calls init(const Particle&,DataSet*) for each particle.
+		*
+		* @param group : the group of the particles
+		* @param dataSet : the data set of the pair renderer/group
+		* @param start : the index of the first particle to initialize
+		* @param end : the index after the last particle to initialize
+		*/
+		virtual void initChunk(const Group& group,DataSet* dataSet,size_t start,size_t end) const;
 		virtual  void update(const Group& group,DataSet* dataSet) const {};
 
 		virtual void render(const Group& group,const DataSet* dataSet,RenderBuffer* renderBuffer) const = 0;
@@ -0,0 +1,289 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef H_SPK_SPATIALINDEX
+#define H_SPK_SPATIALINDEX
+
+#include <vector>
+
+namespace SPK
+{
+	class TaskManager;
+
+	/**
+	* @brief A linear spatial index of the particles of a group
+	*
+	* The spatial index is a uniform grid hashed into buckets and stored in flat arrays.
+	* Each particle is put in the bucket of the cell holding its position and the particles are sorted by bucket with a counting sort.
+	* Within a bucket, particles are ordered by index.<br>
+	* Unlike the Octree, building the index needs no allocation once the arrays have reached their size,
+	* and the cells of the particles are computed in parallel when the system of the group has a TaskManager.<br>
+	* <br>
+	* Several cells can share a same bucket, therefore a bucket can hold particles which are far from each other.
+	* Neighbor queries return candidates which must be tested against their actual distance.
+	* NeighborQuery does it and visits the particles within a radius with an inlined kernel.<br>
+	* <br>
+	* By default the size of the cells is the diameter of the largest particle, so that the neighbors of a particle
+	* are within the cells next to its own. It can be set manually or scaled.<br>
+	* With incremental update enabled, the sort is skipped when no particle changed of bucket since the last update, which is
+	* frequent when particles barely move.<br>
+	* <br>
+	* A spatial index is automatically generated within a group if at least one of its modifiers needs it (by setting its NEEDS_SPATIAL_INDEX constant to true at init).<br>
+	* If no more modifiers need a spatial index and a spatial index exists within the group, it is deleted.
+	*/
+	class SPK_PREFIX SpatialIndex
+	{
+	friend class Group;
+
+	public :
+
+		////////////////
+		// Parameters //
+		////////////////
+
+		/**
+		* @brief Sets the size of the cells
+		* @param cellSize : the size of the cells or 0 to compute it from the radius of the particles
+		*/
+		void setCellSize(float cellSize);
+
+		/**
+		* @brief Gets the size of the cells set by the user
+		* @return the size of the cells or 0 if it is computed from the radius of the particles
+		*/
+		float getCellSize() const;
+
+		/**
+		* @brief Sets the factor applied to the diameter of the largest particle to get the size of the cells
+		*
+		* This is only used when the size of the cells is not set (see setCellSize(float)).<br>
+		* Large cells hold more particles to test while small cells make queries visit more cells. By default the factor is 1.
+		*
+		* @param factor : the factor applied to the diameter of the largest particle
+		*/
+		void setCellSizeFactor(float factor);
+
+		/**
+		* @brief Gets the factor applied to the diameter of the largest particle to get the size of the cells
+		* @return the factor applied to the diameter of the largest particle
+		*/
+		float getCellSizeFactor() const;
+
+		/**
+		* @brief Enables or disables the incremental update
+		*
+		* When enabled, the sort of the particles is skipped if no particle changed of bucket since the last update.<br>
+		* By default, the incremental update is enabled.
+		*
+		* @param incremental : true to enable the incremental update, false to rebuild the index at each update
+		*/
+		void enableIncrementalUpdate(bool incremental);
+
+		/**
+		* @brief Tells whether the incremental update is enabled
+		* @return true if the incremental update is enabled, false if not
+		*/
+		bool isIncrementalUpdateEnabled() const;
+
+		/////////////
+		// Queries //
+		/////////////
+
+		/**
+		* @brief Gets the size of the cells used at the last update
+		* @return the size of the cells used at the last update
+		*/
+		float getCurrentCellSize() const;
+
+		/**
+		* @brief Gets the radius of the largest particle at the last update
+		* @return the radius of the largest particle
+		*/
+		float getMaxRadius() const;
+
+		/**
+		* @brief Gets the number of buckets
+		* @return the number of buckets
+		*/
+		size_t getNbBuckets() const;
+
+		/**
+		* @brief Gets the bucket of a position
+		* @param position : the position
+		* @return the index of the bucket of the position
+		*/
+		size_t getBucket(const Vector3D& position) const;
+
+		/**
+		* @brief Gets the buckets which may hold particles within a distance of a position
+		*
+		* The buckets are sorted and unique.
+		*
+		* @param position : the position
+		* @param distance : the distance
+		* @param buckets : the array filled with the buckets (cleared first)
+		*/
+		void getNeighborBuckets(const Vector3D& position,float distance,std::vector<size_t>& buckets) const;
+
+		/**
+		* @brief Gets the particles of a bucket
+		*
+		* Particles are ordered by index within a bucket.
+		*
+		* @param bucket : the index of the bucket
+		* @param nb : the number of particles in the bucket
+		* @return the indices of the particles of the bucket
+		*/
+		const unsigned int* getParticles(size_t bucket,size_t& nb) const;
+
+		/**
+		* @brief Tells whether the last update skipped the sort of the particles
+		* @return true if the index was reused from the previous update, false if it was rebuilt
+		*/
+		bool isReused() const;
+
+		/**
+		* @brief Gets the size in bytes of the memory allocated by the spatial index
+		* @return the size in bytes of the memory allocated by the spatial index
+		*/
+		size_t getMemorySize() const;
+
+	private :
+
+		class BucketTask;
+
+		static const float MIN_CELL_SIZE;
+		static const size_t MIN_NB_BUCKETS = 64;
+		static const size_t BUCKET_JOB_SIZE = 4096;
+		static const int MAX_CELL_COORDINATE = 1 << 30;
+
+		Group& group;
+
+		float cellSize;
+		float cellSizeFactor;
+		bool incrementalUpdateEnabled;
+
+		float currentCellSize;
+		float invCellSize;
+		float maxRadius;
+		size_t nbBuckets;
+		size_t nbParticles;
+		bool reused;
+
+		std::vector<unsigned int> particleBuckets;	// Bucket of each particle
+		std::vector<unsigned int> bucketStarts;		// Start of each bucket in the sorted particles (nbBuckets + 1 values)
+		std::vector<unsigned int> sortedParticles;	// Particles sorted by bucket
+		std::vector<char> changedJobs;				// Whether a job found a particle which changed of bucket
+
+		// Spatial index life time is managed by Group
+		SpatialIndex(Group& group);
+
+		SpatialIndex(const SpatialIndex& spatialIndex); // never used
+		SpatialIndex& operator=(const SpatialIndex& spatialIndex); // never used
+
+		void update(TaskManager* taskManager); // Used by Group only
+		void copyParameters(const SpatialIndex& spatialIndex);
+
+		void computeBuckets(size_t job);
+		void sortParticles();
+
+		int getCellCoordinate(float value) const;
+		size_t hashCell(int x,int y,int z) const;
+	};
+
+	inline void SpatialIndex::setCellSize(float cellSize)
+	{
+		this->cellSize = cellSize > 0.0f ? cellSize : 0.0f;
+	}
+
+	inline float SpatialIndex::getCellSize() const
+	{
+		return cellSize;
+	}
+
+	inline void SpatialIndex::setCellSizeFactor(float factor)
+	{
+		cellSizeFactor = factor > 0.0f ? factor : 1.0f;
+	}
+
+	inline float SpatialIndex::getCellSizeFactor() const
+	{
+		return cellSizeFactor;
+	}
+
+	inline void SpatialIndex::enableIncrementalUpdate(bool incremental)
+	{
+		incrementalUpdateEnabled = incremental;
+	}
+
+	inline bool SpatialIndex::isIncrementalUpdateEnabled() const
+	{
+		return incrementalUpdateEnabled;
+	}
+
+	inline float SpatialIndex::getCurrentCellSize() const
+	{
+		return currentCellSize;
+	}
+
+	inline float SpatialIndex::getMaxRadius() const
+	{
+		return maxRadius;
+	}
+
+	inline size_t SpatialIndex::getNbBuckets() const
+	{
+		return nbBuckets;
+	}
+
+	inline bool SpatialIndex::isReused() const
+	{
+		return reused;
+	}
+
+	inline int SpatialIndex::getCellCoordinate(float value) const
+	{
+		float coordinate = std::floor(value * invCellSize);
+		if (coordinate > MAX_CELL_COORDINATE) return MAX_CELL_COORDINATE;
+		if (coordinate < -MAX_CELL_COORDINATE) return -MAX_CELL_COORDINATE;
+		return static_cast<int>(coordinate);
+	}
+
+	inline size_t SpatialIndex::hashCell(int x,int y,int z) const
+	{
+		// nbBuckets is a power of 2
+		return ((static_cast<unsigned int>(x) * 73856093u) ^ (static_cast<unsigned int>(y) * 19349663u) ^ (static_cast<unsigned int>(z) * 83492791u)) & (nbBuckets - 1);
+	}
+
+	inline size_t SpatialIndex::getBucket(const Vector3D& position) const
+	{
+		return hashCell(getCellCoordinate(position.x),getCellCoordinate(position.y),getCellCoordinate(position.z));
+	}
+
+	inline const unsigned int* SpatialIndex::getParticles(size_t bucket,size_t& nb) const
+	{
+		nb = bucketStarts[bucket + 1] - bucketStarts[bucket];
+		return &sortedParticles[0] + bucketStarts[bucket];
+	}
+}
+
+#endif
@@ -0,0 +1,224 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_STATS
+#define H_SPK_STATS
+
+#ifdef SPK_PROFILING
+
+#include <vector>
+#include <chrono>
+
+namespace SPK
+{
+	class SPKObject;
+
+	/** @brief Constants defining the stages of the update of a group measured by the profiling */
+	enum ProfileStage
+	{
+		PROFILE_STAGE_EMISSION,			/**< The update of the emitters and the initialization of the born particles */
+		PROFILE_STAGE_INTEGRATION,		/**< The integration of the positions, velocities and ages of the particles */
+		PROFILE_STAGE_INTERPOLATION,	/**< The interpolation of the color and the parameters */
+		PROFILE_STAGE_OCTREE,			/**< The update of the octree and of the spatial index */
+		PROFILE_STAGE_MODIFIERS,		/**< The modification of the particles by the modifiers */
+		PROFILE_STAGE_RENDERER,			/**< The update of the data of the renderer */
+		PROFILE_STAGE_DEATH,			/**< The detection and the removal of the dead particles */
+		PROFILE_STAGE_DISTANCES,		/**< The computation of the distances to the camera */
+		PROFILE_STAGE_SORTING,			/**< The sorting of the particles */
+		PROFILE_STAGE_AABB,				/**< The computation of the axis aligned bounding box */
+	};
+
+	/** @brief The number of profiled stages */
+	const size_t NB_PROFILE_STAGES = PROFILE_STAGE_AABB + 1;
+
+	/**
+	* @brief The counters of the profiling, for a frame or averaged over frames
+	*
+	* Times are in milliseconds. When the update of a stage is split into chunks executed on several threads,
+	* the time is the sum of the times of all the chunks.<br>
+	* The number of bytes touched is an estimate : the size of the data of all the particles updated, born or dead.
+	*/
+	struct StatsCounters
+	{
+		float stageTimes[NB_PROFILE_STAGES];	/**< The time spent in each stage */
+		float nbBornParticles;					/**< The number of particles born */
+		float nbDeadParticles;					/**< The number of particles dead */
+		float nbParticles;						/**< The number of particles alive at the end of the frame */
+		float nbBytesTouched;					/**< The estimated number of bytes of particle data read or written */
+
+		StatsCounters() { clear(); }
+
+		/** @brief Sets all the counters to 0 */
+		void clear();
+
+		/**
+		* @brief Adds the counters of another set of counters
+		* @param counters : the counters to add
+		*/
+		void add(const StatsCounters& counters);
+
+		/**
+		* @brief Moves the counters toward other counters (exponential moving average)
+		* @param counters : the new counters
+		* @param weight : the weight of the new counters within [0,1]
+		*/
+		void blend(const StatsCounters& counters,float weight);
+
+		/**
+		* @brief Gets the total time of all the stages
+		* @return the total time in milliseconds
+		*/
+		float getTotalTime() const;
+	};
+
+	/** @brief The time spent by an interpolator or a modifier */
+	struct HandlerStats
+	{
+		const SPKObject* handler;	/**< The interpolator or the modifier */
+		float time;					/**< The time spent during the last frame in milliseconds */
+		float averageTime;			/**< The time spent on average in milliseconds */
+	};
+
+	/**
+	* @brief The statistics of the profiling of a group or a system
+	*
+	* A frame is a call to System::updateParticles(float). It can include several updates depending on the step mode
+	* or none at all when the system is hidden or skipped by its level of detail.
+	*/
+	struct Stats
+	{
+		StatsCounters frame;					/**< The counters of the last frame */
+		StatsCounters average;					/**< The counters averaged over the last frames */
+		std::vector<HandlerStats> handlers;		/**< The time spent in each interpolator and modifier */
+		size_t nbFrames;						/**< The number of frames profiled */
+
+		Stats() : nbFrames(0) {}
+
+		/** @brief Resets the statistics */
+		void reset();
+
+		/**
+		* @brief Adds the time spent in a handler during the current frame
+		* @param handler : the interpolator or the modifier
+		* @param time : the time in milliseconds
+		*/
+		void addHandlerTime(const SPKObject* handler,float time);
+	};
+
+	/** @brief A timer measuring the time elapsed since its creation or its last restart */
+	class StatsTimer
+	{
+	public :
+
+		StatsTimer() : start(std::chrono::steady_clock::now()) {}
+
+		/** @brief Restarts the timer */
+		void restart() { start = std::chrono::steady_clock::now(); }
+
+		/**
+		* @brief Gets the time elapsed
+		* @return the time elapsed in milliseconds
+		*/
+		float getElapsedTime() const
+		{
+			return std::chrono::duration<float,std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/**
+		* @brief Gets the time elapsed and restarts the timer
+		* @return the time elapsed in milliseconds
+		*/
+		float lap()
+		{
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			const float time = std::chrono::duration<float,std::milli>(now - start).count();
+			start = now;
+			return time;
+		}
+
+	private :
+
+		std::chrono::steady_clock::time_point start;
+	};
+
+	inline void StatsCounters::clear()
+	{
+		for (size_t i = 0; i < NB_PROFILE_STAGES; ++i)
+			stageTimes[i] = 0.0f;
+		nbBornParticles = 0.0f;
+		nbDeadParticles = 0.0f;
+		nbParticles = 0.0f;
+		nbBytesTouched = 0.0f;
+	}
+
+	inline void StatsCounters::add(const StatsCounters& counters)
+	{
+		for (size_t i = 0; i < NB_PROFILE_STAGES; ++i)
+			stageTimes[i] += counters.stageTimes[i];
+		nbBornParticles += counters.nbBornParticles;
+		nbDeadParticles += counters.nbDeadParticles;
+		nbParticles += counters.nbParticles;
+		nbBytesTouched += counters.nbBytesTouched;
+	}
+
+	inline void StatsCounters::blend(const StatsCounters& counters,float weight)
+	{
+		for (size_t i = 0; i < NB_PROFILE_STAGES; ++i)
+			stageTimes[i] += (counters.stageTimes[i] - stageTimes[i]) * weight;
+		nbBornParticles += (counters.nbBornParticles - nbBornParticles) * weight;
+		nbDeadParticles += (counters.nbDeadParticles - nbDeadParticles) * weight;
+		nbParticles += (counters.nbParticles - nbParticles) * weight;
+		nbBytesTouched += (counters.nbBytesTouched - nbBytesTouched) * weight;
+	}
+
+	inline float StatsCounters::getTotalTime() const
+	{
+		float totalTime = 0.0f;
+		for (size_t i = 0; i < NB_PROFILE_STAGES; ++i)
+			totalTime += stageTimes[i];
+		return totalTime;
+	}
+
+	inline void Stats::reset()
+	{
+		frame.clear();
+		average.clear();
+		handlers.clear();
+		nbFrames = 0;
+	}
+
+	inline void Stats::addHandlerTime(const SPKObject* handler,float time)
+	{
+		for (std::vector<HandlerStats>::iterator it = handlers.begin(); it != handlers.end(); ++it)
+			if (it->handler == handler)
+			{
+				it->time += time;
+				return;
+			}
+
+		HandlerStats stats = {handler,time,time};
+		handlers.push_back(stats);
+	}
+}
+
+#endif
+
+#endif
@@ -59,6 +59,8 @@ namespace SPK
 	*/
 	class SPK_PREFIX System : public Transformable
 	{
+	friend class BudgetManager;
+	friend class Group;
 
 	public :
 
@@ -171,6 +173,33 @@ namespace SPK
 		*/
 		virtual void renderParticles() const;
 
+		/**
+		* @brief Simulates the system for a given time as fast as possible
+		*
+		* This brings effects in their steady state before they are first displayed (fog, waterfalls...).<br>
+		* The system is updated with large steps and everything only needed for display is skipped during the steps :
+		* computation of distances, update of renderers, sorting and computation of the AABB. They are performed once at the end.<br>
+		* Particles born before the last maximum life time of the given time would be dead at the end,
+		* so that part of the time only updates the tanks of emitters. When groups spawn particles in other groups (EmitterAttacher, SpawnParticlesAction...),
+		* the life times of the chain are summed. The cost of a prewarm is therefore bounded by the life time of particles,
+		* unless a group is immortal or groups feed each other.<br>
+		* <br>
+		* The step mode, the levels of detail and the visibility of the system are ignored.
+		*
+		* @param time : the time to simulate
+		* @param step : the time step used for the simulation
+		*/
+		void prewarm(float time,float step = 0.1f);
+
+		/**
+		* @brief Resets the system in the state of a new system
+		*
+		* All the particles are removed, including the ones added manually and not yet emitted,
+		* the tanks of emitters are reset, the system is made visible and the time carried between updates is dropped.<br>
+		* The configuration of the system is not modified.
+		*/
+		void reset();
+
 		//////////////////
 		// Bounding Box //
 		//////////////////
@@ -226,6 +255,20 @@ namespace SPK
 		*/
 		const Vector3D& getCameraPosition();
 
+		////////////
+		// Random //
+		////////////
+
+		/**
+		* @brief Seeds the random generators of all the groups of the system
+		*
+		* Each group gets a different seed derived from the given one and from its index in the system.<br>
+		* With the same seed, the same step mode and the same sequence of time steps, a system always evolves the same way.
+		*
+		* @param seed : the seed
+		*/
+		void setRandomSeed(unsigned int seed);
+
 		///////////////
 		// Step Mode //
 		///////////////
@@ -292,6 +335,240 @@ namespace SPK
 		*/
 		static StepMode getStepMode();
 
+		/**
+		* @brief Enables or disables the interpolation of rendering between updates
+		*
+		* With a constant or adaptive step, the time left after the last update is carried to the next call.
+		* Without interpolation, particles are rendered at their last updated state which makes them stutter when the step is coarse.<br>
+		* When interpolation is enabled, particles are rendered at a position interpolated between their old and current positions
+		* according to the time left. The simulation can then run at a low rate (20 to 30 updates per second) while rendering stays smooth.<br>
+		* <br>
+		* Note that the rendered state lags one step behind the simulated state and that only positions are interpolated.<br>
+		* This has no effect in real step mode.
+		*
+		* @param interpolation : true to enable the interpolation, false to disable it
+		*/
+		void enableRenderInterpolation(bool interpolation);
+
+		/**
+		* @brief Tells whether the interpolation of rendering is enabled
+		* @return true if the interpolation of rendering is enabled, false if not
+		*/
+		bool isRenderInterpolationEnabled() const;
+
+		/**
+		* @brief Gets the ratio used to interpolate positions at rendering
+		*
+		* This is the time left after the last update divided by the update step.
+		* It is 1 when interpolation is disabled, which means particles are rendered at their current positions.
+		*
+		* @return the interpolation ratio within [0,1]
+		*/
+		float getInterpolationRatio() const;
+
+		//////////////////
+		// Task manager //
+		//////////////////
+
+		/**
+		* @brief Sets the task manager used to update the groups of this system by chunks
+		*
+		* When a task manager is set, the per particle stages of the update of groups bigger than their chunk size
+		* are split into chunks that are processed in parallel (see Group::setChunkSize(size_t)).<br>
+		* Only chunk safe interpolators and modifiers are processed by chunks, other ones are executed serially.<br>
+		* <br>
+		* The task manager is not owned by the system and must outlive it. NULL (the default) updates groups serially.
+		*
+		* @param taskManager : the task manager to use or NULL
+		*/
+		void setTaskManager(TaskManager* taskManager);
+
+		/**
+		* @brief Gets the task manager used to update the groups of this system by chunks
+		* @return the task manager or NULL if groups are updated serially
+		*/
+		TaskManager* getTaskManager() const;
+
+		////////////////
+		// Update LOD //
+		////////////////
+
+		/**
+		* @brief Adds a level of detail for the update of the system
+		*
+		* When the distance between the camera and the system is greater than the given distance,
+		* the system is only updated every updatePeriod calls to updateParticles(float) with the time accumulated since its last update.<br>
+		* The level with the greatest distance lower than the actual distance is used.<br>
+		* <br>
+		* Each system has its own phase so that systems at the same level are updated at different frames, which spreads the cost of updates.<br>
+		* The distance is measured from the center of the AABB of the system if its computation is enabled and from the position of the system otherwise.
+		* The camera position must therefore be set (see setCameraPosition(const Vector3D&)).
+		*
+		* @param distance : the distance from which the level is used
+		* @param updatePeriod : the number of calls to updateParticles(float) between 2 updates
+		*/
+		void addLODLevel(float distance,unsigned int updatePeriod);
+
+		/** @brief Removes all the levels of detail, the system is then updated at each call */
+		void removeAllLODLevels();
+
+		/**
+		* @brief Gets the number of levels of detail of the system
+		* @return the number of levels of detail
+		*/
+		size_t getNbLODLevels() const;
+
+		/**
+		* @brief Gets the update period in use at the last call to updateParticles(float)
+		* @return the current update period (1 means the system is updated at each call)
+		*/
+		unsigned int getCurrentLODPeriod() const;
+
+		////////////////
+		// Visibility //
+		////////////////
+
+		/**
+		* @brief Sets whether the system is visible
+		*
+		* A hidden system is not simulated, updateParticles(float) only accumulates the time elapsed.<br>
+		* When the system becomes visible again, it catches up with the time elapsed in a few large steps (see setCatchUpStep(float)).
+		* Particles that would have died during that time are removed and the tanks of emitters are updated without emitting.<br>
+		* <br>
+		* This can be set directly when the visibility is computed by the engine or with updateVisibility(const Frustum&).
+		* A system is visible by default.
+		*
+		* @param visible : true if the system is visible, false if not
+		*/
+		void setVisible(bool visible);
+
+		/**
+		* @brief Tells whether the system is visible
+		* @return true if the system is visible, false if not
+		*/
+		bool isVisible() const;
+
+		/**
+		* @brief Sets the visibility of the system by testing its conservative bounds against a frustum
+		*
+		* This must be called before updateParticles(float) each frame the system may change of visibility.
+		*
+		* @param frustum : the view frustum in world space
+		* @return true if the system is visible, false if not
+		*/
+		bool updateVisibility(const Frustum& frustum);
+
+		/**
+		* @brief Computes a box bounding all the positions particles of the system can reach during their life
+		*
+		* The box holds the living particles extended by the distance they can travel before dying
+		* and the zones of the emitters extended by the distance the particles they will emit can travel.<br>
+		* Distances are derived from the speed of particles, the forces of emitters, the life times and the acceleration of modifiers
+		* (see Modifier::getMaxAcceleration(const Group&)). The lowest mass of particles is given by the bounds of the mass (see Group::getParamBounds(Param,float&,float&)).<br>
+		* The bounds of immortal groups, of groups with particles added manually, of groups whose lowest mass is unknown
+		* and of groups with a modifier whose acceleration cannot be bounded (vortices, relative linear forces...) cover the whole space.
+		* The speed exchanged by colliding particles is not accounted for and must be covered with setVisibilityMargin(float).
+		*
+		* @param AABBMin : the minimum coordinates of the box
+		* @param AABBMax : the maximum coordinates of the box
+		*/
+		void computeConservativeAABB(Vector3D& AABBMin,Vector3D& AABBMax) const;
+
+		/**
+		* @brief Sets a margin added to the conservative bounds of the system
+		* @param margin : the margin
+		*/
+		void setVisibilityMargin(float margin);
+
+		/**
+		* @brief Gets the margin added to the conservative bounds of the system
+		* @return the margin
+		*/
+		float getVisibilityMargin() const;
+
+		/**
+		* @brief Sets the time step used to catch up with the time elapsed while the system was hidden
+		*
+		* Only the last maximum life time of the time elapsed is simulated as older particles are dead anyway.
+		* A large step is cheap but less accurate. No more than 32 steps are performed :
+		* only the last 32 steps of the hidden time are simulated and the time before is dropped, as if the system had been paused.
+		*
+		* @param catchUpStep : the time step used to catch up
+		*/
+		void setCatchUpStep(float catchUpStep);
+
+		/**
+		* @brief Gets the time step used to catch up with the time elapsed while the system was hidden
+		* @return the time step used to catch up
+		*/
+		float getCatchUpStep() const;
+
+		////////////
+		// Budget //
+		////////////
+
+		/**
+		* @brief Gets the scale applied to the emission of the groups of the system
+		*
+		* The scale is set by the BudgetManager when the system is registered in it and is 1 otherwise.<br>
+		* The number of particles emitted by the emitters of the groups during their update is multiplied by this scale.
+		*
+		* @return the emission scale within [0,1]
+		*/
+		float getEmissionScale() const;
+
+#ifdef SPK_PROFILING
+		///////////////
+		// Profiling //
+		///////////////
+
+		/**
+		* @brief Enables or disables the profiling of the system
+		*
+		* When enabled, the time spent in each stage of the update of the groups is measured at each call to updateParticles(float),
+		* as well as the number of particles born and dead. Profiling is only available when SPARK is built with SPK_PROFILING defined,
+		* it costs nothing otherwise.<br>
+		* By default, profiling is disabled.
+		*
+		* @param profiling : true to enable profiling, false to disable it
+		*/
+		void enableProfiling(bool profiling);
+
+		/**
+		* @brief Tells whether the profiling of the system is enabled
+		* @return true if profiling is enabled, false if not
+		*/
+		bool isProfilingEnabled() const;
+
+		/**
+		* @brief Gets the statistics of the profiling of the system
+		*
+		* The statistics of the system are the sum of the statistics of its groups (see Group::getStats()).
+		* The averages are exponential moving averages over about 20 frames.
+		*
+		* @return the statistics of the system
+		*/
+		const Stats& getStats() const;
+
+		/** @brief Resets the statistics of the system and of its groups */
+		void resetStats();
+#endif
+
+#ifdef SPK_MEMORY_STATISTICS
+		////////////
+		// Memory //
+		////////////
+
+		/**
+		* @brief Gets the memory statistics of the system
+		*
+		* The statistics count the memory of the groups of the system and are updated at the end of the update of each group.
+		*
+		* @return the memory statistics of the system
+		*/
+		const MemoryStatistics& getMemoryStatistics() const;
+#endif
+
 		//////////
 		// Misc //
 		//////////
@@ -331,6 +608,60 @@ namespace SPK
 
 		Vector3D cameraPosition;
 
+		TaskManager* taskManager;
+
+		// Update LOD
+		struct LODLevel
+		{
+			float sqrDistance;
+			unsigned int updatePeriod;
+
+			bool operator<(const LODLevel& level) const { return sqrDistance < level.sqrDistance; }
+		};
+
+		static unsigned int nextLODPhase;
+
+		std::vector<LODLevel> LODLevels;
+		unsigned int LODPhase;
+		unsigned int LODFrame;
+		unsigned int currentLODPeriod;
+		float LODDeltaTime;
+
+		unsigned int computeLODPeriod() const;
+
+		// Budget
+		float emissionScale;
+		bool budgetRegistered;
+
+#ifdef SPK_MEMORY_STATISTICS
+		MemoryStatistics memoryStatistics;
+#endif
+
+#ifdef SPK_PROFILING
+		// Profiling
+		static const float PROFILING_AVERAGE_WEIGHT;
+
+		bool profilingEnabled;
+		Stats stats;
+
+		void endStatsFrame();
+#endif
+
+		// Visibility
+		bool visible;
+		float hiddenTime;
+		float visibilityMargin;
+		float catchUpStep;
+
+		mutable bool particleBoundsValid;
+		mutable Vector3D particleBoundsMin;
+		mutable Vector3D particleBoundsMax;
+
+		static const size_t MAX_CATCH_UP_STEPS = 32;
+
+		float computeMaxChainedLifeTime() const;
+		void fastForward(float time,float step,size_t maxNbSteps);
+
 		// Step mode
 		static StepMode stepMode;
 		static float constantStep;
@@ -342,6 +673,9 @@ namespace SPK
 
 		float deltaStep;
 
+		bool renderInterpolationEnabled;
+		float interpolationRatio;
+
 		bool initialized;
 		bool active;
 
@@ -350,7 +684,9 @@ namespace SPK
 		Vector3D AABBMin;
 		Vector3D AABBMax;
 
-		bool innerUpdate(float deltaTime);
+		bool updateFrame(float deltaTime);
+		bool innerUpdate(float deltaTime,bool display = true);
+		void updateDisplay();
 
 		static void setGroupSystem(const Ref<Group>& group,System* system,bool remove = true);
 	};
@@ -376,6 +712,55 @@ namespace SPK
 		return groups.size();
 	}
 
+	inline float System::getEmissionScale() const
+	{
+		return emissionScale;
+	}
+
+#ifdef SPK_PROFILING
+	inline void System::enableProfiling(bool profiling)
+	{
+		profilingEnabled = profiling;
+	}
+
+	inline bool System::isProfilingEnabled() const
+	{
+		return profilingEnabled;
+	}
+
+	inline const Stats& System::getStats() const
+	{
+		return stats;
+	}
+#endif
+
+#ifdef SPK_MEMORY_STATISTICS
+	inline const MemoryStatistics& System::getMemoryStatistics() const
+	{
+		return memoryStatistics;
+	}
+#endif
+
+	inline void System::setVisible(bool visible)
+	{
+		this->visible = visible;
+	}
+
+	inline bool System::isVisible() const
+	{
+		return visible;
+	}
+
+	inline float System::getVisibilityMargin() const
+	{
+		return visibilityMargin;
+	}
+
+	inline float System::getCatchUpStep() const
+	{
+		return catchUpStep;
+	}
+
 	inline void System::addController(const Ref<Controller>& ctrl)
 	{
 		if(ctrl)
@@ -452,11 +837,53 @@ namespace SPK
 		stepMode = STEP_MODE_REAL;
 	}
 
+	inline void System::enableRenderInterpolation(bool interpolation)
+	{
+		renderInterpolationEnabled = interpolation;
+		if (!interpolation)
+			interpolationRatio = 1.0f;
+	}
+
+	inline bool System::isRenderInterpolationEnabled() const
+	{
+		return renderInterpolationEnabled;
+	}
+
+	inline float System::getInterpolationRatio() const
+	{
+		return interpolationRatio;
+	}
+
 	inline StepMode System::getStepMode()
 	{
 		return stepMode;
 	}
 
+	inline void System::setTaskManager(TaskManager* taskManager)
+	{
+		this->taskManager = taskManager;
+	}
+
+	inline TaskManager* System::getTaskManager() const
+	{
+		return taskManager;
+	}
+
+	inline void System::removeAllLODLevels()
+	{
+		LODLevels.clear();
+	}
+
+	inline size_t System::getNbLODLevels() const
+	{
+		return LODLevels.size();
+	}
+
+	inline unsigned int System::getCurrentLODPeriod() const
+	{
+		return currentLODPeriod;
+	}
+
 	inline bool System::isInitialized() const
 	{
 		return initialized;
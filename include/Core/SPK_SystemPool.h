@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_SYSTEMPOOL
+#define H_SPK_SYSTEMPOOL
+
+#include <vector>
+#include <set>
+
+namespace SPK
+{
+	/**
+	* @brief A pool of instances of a prototype system
+	*
+	* Spawning an effect by copying a whole system deep copies all its objects and reallocates the storage of its groups.
+	* A pool copies its prototype only when it has no free instance left and recycles the released instances.<br>
+	* <br>
+	* The configuration of the prototype (interpolators, renderers and modifiers not local to the system) is shared by the instances
+	* (see shareConfiguration(const Ref<System>&)). Each instance only owns its groups, its emitters with their zones and tanks,
+	* its actions and its controllers.<br>
+	* Only objects holding no reference to the objects owned by a system are shared. A modifier referencing a group,
+	* such as an EmitterAttacher, tells so with Modifier::isShareable() and is copied for each instance. The shared configuration must not be modified while instances are in use
+	* unless the modification is meant for all of them.<br>
+	* <br>
+	* The pool is not thread safe.
+	*/
+	class SPK_PREFIX SystemPool
+	{
+	public :
+
+		/////////////////////////////
+		// Constructor/Destructor  //
+		/////////////////////////////
+
+		/**
+		* @brief Constructor of system pool
+		*
+		* The configuration of the prototype is made shared.
+		*
+		* @param prototype : the system the instances are copied from
+		* @param nbInstances : the number of instances to create up front
+		*/
+		SystemPool(const Ref<System>& prototype,size_t nbInstances = 0);
+
+		/**
+		* @brief Gets the prototype of the pool
+		* @return the prototype of the pool
+		*/
+		const Ref<System>& getPrototype() const;
+
+		///////////////
+		// Instances //
+		///////////////
+
+		/**
+		* @brief Gets an instance from the pool
+		*
+		* A released instance is reused if any, otherwise a new one is copied from the prototype.
+		* The instance is in the state of a new system : no particle, full tanks, visible...
+		*
+		* @return an instance of the prototype
+		*/
+		Ref<System> acquire();
+
+		/**
+		* @brief Gives an instance back to the pool
+		*
+		* The instance is reset so that it can be reused. It must not be used by the caller anymore.<br>
+		* Only the instances acquired from this pool and not released yet can be released.
+		* Other systems, such as the prototype or instances already released, are rejected with a warning.
+		*
+		* @param system : the instance to give back
+		*/
+		void release(const Ref<System>& system);
+
+		/**
+		* @brief Creates instances up front so that the next acquisitions do not copy the prototype
+		* @param nbInstances : the number of free instances the pool must have
+		*/
+		void reserve(size_t nbInstances);
+
+		/**
+		* @brief Gets the number of free instances in the pool
+		* @return the number of free instances
+		*/
+		size_t getNbFreeInstances() const;
+
+		/**
+		* @brief Gets the number of instances created by the pool
+		* @return the number of instances created
+		*/
+		size_t getNbCreatedInstances() const;
+
+		/**
+		* @brief Makes shared the objects of a system that do not hold state of an instance
+		*
+		* Color and parameter interpolators, renderers and modifiers not local to the system are made shared
+		* so that they are referenced and not copied when the system is copied.<br>
+		* Emitters and their zones, local modifiers, actions and controllers depend on the transform or the state of an instance
+		* and are left as they are. So are the modifiers which cannot be shared (see Modifier::isShareable()).
+		*
+		* @param system : the system whose configuration must be shared
+		*/
+		static void shareConfiguration(const Ref<System>& system);
+
+	private :
+
+		Ref<System> prototype;
+		std::vector<Ref<System> > freeInstances;
+		std::set<const System*> usedInstances; // Instances acquired and not released yet
+		size_t nbCreatedInstances;
+
+		Ref<System> createInstance();
+
+		static void share(SPKObject* object);
+
+		SystemPool(const SystemPool&); // Not used
+		SystemPool& operator=(const SystemPool&); // Not used
+	};
+
+	inline const Ref<System>& SystemPool::getPrototype() const
+	{
+		return prototype;
+	}
+
+	inline size_t SystemPool::getNbFreeInstances() const
+	{
+		return freeInstances.size();
+	}
+
+	inline size_t SystemPool::getNbCreatedInstances() const
+	{
+		return nbCreatedInstances;
+	}
+}
+
+#endif
@@ -0,0 +1,178 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_SYSTEMSCHEDULER
+#define H_SPK_SYSTEMSCHEDULER
+
+#include <vector>
+
+namespace SPK
+{
+	/**
+	* @brief A class updating a batch of systems in parallel
+	*
+	* Each System of the batch is updated as a job of a TaskManager, so independent systems are updated concurrently.<br>
+	* By default the scheduler uses its own ThreadPool but any TaskManager can be set, typically to run SPARK on the job system of an engine.<br>
+	* <br>
+	* Systems are updated concurrently, therefore the following rules apply :
+	* <ul>
+	* <li>A system must appear only once in the batch</li>
+	* <li>Objects shared between systems of a batch (shared zones, modifiers, renderers...) must not be modified during the update</li>
+	* <li>A group must not emit particles into a group of another system of the batch (through an action or an EmitterAttacher for instance)</li>
+	* </ul>
+	* Rendering is not handled by the scheduler and must still be performed from the rendering thread.<br>
+	* <br>
+	* When memory tracing is enabled (SPK_TRACE_MEMORY), the systems are updated one after the other as the tracer is not thread safe.
+	*/
+	class SPK_PREFIX SystemScheduler
+	{
+	public :
+
+		/////////////////////////////
+		// Constructor/Destructor  //
+		/////////////////////////////
+
+		/**
+		* @brief Constructor of system scheduler
+		* @param taskManager : the task manager used to dispatch the updates. If NULL, a default thread pool is used
+		*/
+		SystemScheduler(TaskManager* taskManager = NULL);
+		~SystemScheduler();
+
+		//////////////////
+		// Task manager //
+		//////////////////
+
+		/**
+		* @brief Sets the task manager used to dispatch the updates
+		*
+		* The task manager is not owned by the scheduler and must outlive it.<br>
+		* If NULL, a default thread pool is used.
+		*
+		* @param taskManager : the task manager to use
+		*/
+		void setTaskManager(TaskManager* taskManager);
+
+		/**
+		* @brief Gets the task manager set to dispatch the updates
+		* @return the task manager or NULL if the default thread pool is used
+		*/
+		TaskManager* getTaskManager() const;
+
+		////////////////////////
+		// Systems management //
+		////////////////////////
+
+		/**
+		* @brief Adds a system to the scheduler
+		* @param system : the system to add
+		*/
+		void addSystem(const Ref<System>& system);
+
+		/**
+		* @brief Removes a system from the scheduler
+		* @param system : the system to remove
+		*/
+		void removeSystem(const Ref<System>& system);
+
+		/** @brief Removes all the systems from the scheduler */
+		void removeAllSystems();
+
+		/**
+		* @brief Gets the system at index
+		* @param index : the index of the system
+		* @return the system at index
+		*/
+		const Ref<System>& getSystem(size_t index) const;
+
+		/**
+		* @brief Gets the number of systems in the scheduler
+		* @return the number of systems
+		*/
+		size_t getNbSystems() const;
+
+		////////////
+		// Update //
+		////////////
+
+		/**
+		* @brief Updates all the systems of the scheduler
+		*
+		* This is the parallel equivalent of calling System::updateParticles(float) on each system.<br>
+		* The activity of each system can be checked afterwards with System::isActive().
+		*
+		* @param deltaTime : the time step
+		* @return true if at least one system is still active
+		*/
+		bool updateParticles(float deltaTime);
+
+		/**
+		* @brief Updates a batch of systems
+		*
+		* The systems passed do not need to be registered in the scheduler.
+		*
+		* @param systems : the systems to update
+		* @param deltaTime : the time step
+		* @return true if at least one system is still active
+		*/
+		bool updateParticles(const std::vector<Ref<System> >& systems,float deltaTime);
+
+	private :
+
+		class UpdateTask;
+
+		std::vector<Ref<System> > systems;
+
+		TaskManager* taskManager;
+		ThreadPool* defaultTaskManager;
+
+		SystemScheduler(const SystemScheduler&); // Not used
+		SystemScheduler& operator=(const SystemScheduler&); // Not used
+	};
+
+	inline TaskManager* SystemScheduler::getTaskManager() const
+	{
+		return taskManager;
+	}
+
+	inline void SystemScheduler::removeAllSystems()
+	{
+		systems.clear();
+	}
+
+	inline const Ref<System>& SystemScheduler::getSystem(size_t index) const
+	{
+		SPK_ASSERT(index < getNbSystems(),"SystemScheduler::getSystem(size_t) - Index of system is out of bounds : " << index);
+		return systems[index];
+	}
+
+	inline size_t SystemScheduler::getNbSystems() const
+	{
+		return systems.size();
+	}
+
+	inline bool SystemScheduler::updateParticles(float deltaTime)
+	{
+		return updateParticles(systems,deltaTime);
+	}
+}
+
+#endif
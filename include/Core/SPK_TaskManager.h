@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef H_SPK_TASKMANAGER
+#define H_SPK_TASKMANAGER
+
+namespace SPK
+{
+	/**
+	* @brief A piece of work that can be split into independent jobs
+	*
+	* A task is run by a TaskManager which calls execute(size_t) once for each job index within [0,nbJobs[.<br>
+	* Jobs can be executed concurrently and in any order, therefore a job must only write data it owns.
+	*/
+	class SPK_PREFIX Task
+	{
+	public :
+
+		virtual ~Task() {}
+
+		/**
+		* @brief Executes a single job of the task
+		* @param jobIndex : the index of the job to execute, within [0,nbJobs[
+		*/
+		virtual void execute(size_t jobIndex) = 0;
+	};
+
+	/**
+	* @brief An interface allowing SPARK to dispatch work on several threads
+	*
+	* SPARK never creates threads on its own, it only goes through a TaskManager.<br>
+	* An engine owning a job system can therefore implement this interface to have SPARK work run on its own workers.<br>
+	* A ThreadPool is provided as a default implementation.
+	*/
+	class SPK_PREFIX TaskManager
+	{
+	public :
+
+		virtual ~TaskManager() {}
+
+		/**
+		* @brief Executes all the jobs of a task and waits for their completion
+		*
+		* This method must not return before every job in [0,nbJobs[ has been executed.<br>
+		* It can be called from within a job (nested call) or from several threads at once and must not deadlock in that case.
+		* Running the jobs on the calling thread is always a valid fallback.
+		*
+		* @param task : the task to execute
+		* @param nbJobs : the number of jobs of the task
+		*/
+		virtual void execute(Task& task,size_t nbJobs) = 0;
+
+		/**
+		* @brief Gets the number of threads that may execute jobs concurrently
+		*
+		* This is used by SPARK to decide how finely work is split.
+		*
+		* @return the number of threads, the calling one included
+		*/
+		virtual size_t getNbThreads() const = 0;
+	};
+
+	/**
+	* @brief The default TaskManager of SPARK
+	*
+	* The thread pool starts its worker threads at construction and stops them at destruction.<br>
+	* The calling thread takes part in the execution of the jobs and jobs are handed out one at a time to the first thread available,
+	* which balances the load when jobs have different costs.<br>
+	* <br>
+	* A single task is executed at a time by the pool.
+	* A call to execute(Task&,size_t) while the pool is busy (nested call or concurrent call from another thread) runs its jobs on the calling thread.<br>
+	* <br>
+	* When SPARK is built with SPK_NO_THREADS defined, no thread is created and all jobs run on the calling thread.
+	*/
+	class SPK_PREFIX ThreadPool : public TaskManager
+	{
+	public :
+
+		/**
+		* @brief Constructor of thread pool
+		* @param nbThreads : the number of threads executing jobs, the calling thread included.
+		* If 0, the number of hardware threads is used
+		*/
+		ThreadPool(size_t nbThreads = 0);
+		virtual ~ThreadPool();
+
+		virtual void execute(Task& task,size_t nbJobs);
+		virtual size_t getNbThreads() const;
+
+	private :
+
+		struct Implementation;
+		Implementation* implementation;
+
+		ThreadPool(const ThreadPool&); // Not used
+		ThreadPool& operator=(const ThreadPool&); // Not used
+	};
+}
+
+#endif
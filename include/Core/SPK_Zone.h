@@ -80,6 +80,17 @@ namespace SPK
 		virtual bool contains(const Vector3D& v,float radius = 0.0f) const = 0;
 		virtual bool intersects(const Vector3D& v0,const Vector3D& v1,float radius = 0.0f,Vector3D* normal = NULL) const = 0;
 		virtual Vector3D computeNormal(const Vector3D& v) const = 0;
+
+		/**
+		* @brief Computes an axis aligned box bounding the zone
+		*
+		* The box bounds the transformed zone.<br>
+		* By default a zone is considered as unbounded and the box covers the whole space.
+		*
+		* @param AABBMin : the minimum coordinates of the box
+		* @param AABBMax : the maximum coordinates of the box
+		*/
+		virtual void computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const;
 		
 		/**
 		* Performs a check for a particle on the zone
@@ -41,6 +41,7 @@ namespace SPK
 		void clearActions();
 
 		virtual void apply(Particle& particle) const;
+		virtual bool spawnsInto(const Group& group) const;
 
 		virtual Ref<SPKObject> findByName(const std::string& name);
 
@@ -134,6 +134,7 @@ namespace SPK
 		void resetPool();
 
 		virtual void apply(Particle& particle) const;
+		virtual bool spawnsInto(const Group& group) const { return targetGroup.get() == &group; }
 		virtual Ref<SPKObject> findByName(const std::string& name);
 
 	public :
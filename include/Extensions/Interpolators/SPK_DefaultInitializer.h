@@ -36,6 +36,8 @@ namespace SPK
 		void setDefaultValue(Tv value);
 		Tv getDefaultValue() const;
 
+		virtual bool getBounds(T& min,T& max) const;
+
 	public :
 		spark_description(DefaultInitializer, Interpolator)
 		(
@@ -83,6 +85,13 @@ namespace SPK
 		return defaultValue;
 	}
 
+	template<typename T>
+	inline bool DefaultInitializer<T>::getBounds(T& min,T& max) const
+	{
+		min = max = defaultValue;
+		return true;
+	}
+
 	template<typename T>
 	inline void DefaultInitializer<T>::init(T& data,Particle& particle,DataSet* dataSet) const
 	{
@@ -22,6 +22,7 @@
 #ifndef H_SPK_GRAPHINTERPOLATOR
 #define H_SPK_GRAPHINTERPOLATOR
 
+#include <algorithm>
 #include <cmath> // for std::abs
 #include <vector>
 
@@ -224,6 +225,8 @@ namespace SPK
 		/** @brief Removes an entry specified by index */
 		void removeEntry(unsigned int id);
 
+		virtual bool getBounds(T& min,T& max) const;
+
 	public :
 		void createEntry();
 		void setX(unsigned id, float x);
@@ -281,6 +284,7 @@ namespace SPK
 		virtual void createData(DataSet& dataSet,const Group& group) const;
 
 		virtual void interpolate(T* data, Group& group, DataSet* dataSet) const;
+		virtual void interpolateChunk(T* data, Group& group, DataSet* dataSet, size_t start, size_t end) const;
 		virtual void init(T& data, Particle& particle, DataSet* dataSet) const;
 		
 		void sortGraph(unsigned int start);
@@ -293,6 +297,29 @@ namespace SPK
 		void interpolateParticle(T& data,const Particle& particle,float offsetX,float scaleX,float ratioY) const;
 	};
 
+	template<typename T>
+	inline bool GraphInterpolator<T>::getBounds(T& min,T& max) const
+	{
+		return false;
+	}
+
+	template<>
+	inline bool GraphInterpolator<float>::getBounds(float& min,float& max) const
+	{
+		if (graph.empty())
+			return false;
+
+		// Values are interpolated linearly between the entries and their ys
+		min = std::min(graph[0].y0,graph[0].y1);
+		max = std::max(graph[0].y0,graph[0].y1);
+		for (size_t i = 1; i < graph.size(); ++i)
+		{
+			min = std::min(min,std::min(graph[i].y0,graph[i].y1));
+			max = std::max(max,std::max(graph[i].y0,graph[i].y1));
+		}
+		return true;
+	}
+
 	typedef GraphInterpolator<Color> ColorGraphInterpolator;
 	typedef GraphInterpolator<float> FloatGraphInterpolator;
 
@@ -316,7 +343,7 @@ namespace SPK
 
 	template<typename T>
 	GraphInterpolator<T>::GraphInterpolator() :
-		Interpolator<T>(true),
+		Interpolator<T>(true,true),
 		type(INTERPOLATOR_LIFETIME),
 		param(PARAM_SCALE),
 		scaleXVariation(0.0f),
@@ -654,13 +681,19 @@ namespace SPK
 	template<typename T>
 	void GraphInterpolator<T>::interpolate(T* data, Group& group, DataSet* dataSet) const
 	{
-		SPK_ASSERT(!graph.empty(),"GraphInterpolator<T>::interpolate(T*,Group&,DataSet*) const - The graph of the interpolator is empty. Cannot interpolate");
+		interpolateChunk(data,group,dataSet,0,group.getNbParticles());
+	}
+
+	template<typename T>
+	void GraphInterpolator<T>::interpolateChunk(T* data, Group& group, DataSet* dataSet, size_t start, size_t end) const
+	{
+		SPK_ASSERT(!graph.empty(),"GraphInterpolator<T>::interpolateChunk(T*,Group&,DataSet*,size_t,size_t) const - The graph of the interpolator is empty. Cannot interpolate");
 
 		FloatArrayData& offsetXData = SPK_GET_DATA(FloatArrayData,dataSet,OFFSET_X_DATA_INDEX);
 		FloatArrayData& scaleXData = SPK_GET_DATA(FloatArrayData,dataSet,SCALE_X_DATA_INDEX);
 		FloatArrayData& ratioYData = SPK_GET_DATA(FloatArrayData,dataSet,RATIO_Y_DATA_INDEX);
 
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 		{
 			size_t index = particleIt->getIndex();
 			interpolateParticle(data[index],*particleIt,offsetXData[index],scaleXData[index],ratioYData[index]);
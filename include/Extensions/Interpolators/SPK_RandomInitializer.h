@@ -22,6 +22,8 @@
 #ifndef H_SPK_RANDOMINITIALIZER
 #define H_SPK_RANDOMINITIALIZER
 
+#include <algorithm>
+
 namespace SPK
 {
 	template<typename T>
@@ -37,6 +39,8 @@ namespace SPK
 		Tv getMinValue() const;
 		Tv getMaxValue() const;
 
+		virtual bool getBounds(T& min,T& max) const;
+
 	public :
 		spark_description(RandomInitializer, Interpolator)
 		(
@@ -55,6 +59,20 @@ namespace SPK
 		virtual void init(T& data,Particle& particle,DataSet* dataSet) const;
 	};
 
+	template<typename T>
+	inline bool RandomInitializer<T>::getBounds(T& min,T& max) const
+	{
+		return false;
+	}
+
+	template<>
+	inline bool RandomInitializer<float>::getBounds(float& min,float& max) const
+	{
+		min = std::min(minValue,maxValue);
+		max = std::max(minValue,maxValue);
+		return true;
+	}
+
 	typedef RandomInitializer<Color> ColorRandomInitializer;
 	typedef RandomInitializer<float> FloatRandomInitializer;
 
@@ -22,6 +22,8 @@
 #ifndef H_SPK_RANDOMINTERPOLATOR
 #define H_SPK_RANDOMINTERPOLATOR
 
+#include <algorithm>
+
 namespace SPK
 {
 	template<typename T>
@@ -40,6 +42,8 @@ namespace SPK
 		Tv getMinDeathValue() const;
 		Tv getMaxDeathValue() const;
 
+		virtual bool getBounds(T& min,T& max) const;
+
 	public :
 		spark_description(RandomInterpolator, Interpolator)
 		(
@@ -68,9 +72,24 @@ namespace SPK
 		virtual void createData(DataSet& dataSet,const Group& group) const;
 
 		virtual void interpolate(T* data,Group& group,DataSet* dataSet) const;
+		virtual void interpolateChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const;
 		virtual void init(T& data,Particle& particle,DataSet* dataSet) const;
 	};
 
+	template<typename T>
+	inline bool RandomInterpolator<T>::getBounds(T& min,T& max) const
+	{
+		return false;
+	}
+
+	template<>
+	inline bool RandomInterpolator<float>::getBounds(float& min,float& max) const
+	{
+		min = std::min(std::min(minBirthValue,maxBirthValue),std::min(minDeathValue,maxDeathValue));
+		max = std::max(std::max(minBirthValue,maxBirthValue),std::max(minDeathValue,maxDeathValue));
+		return true;
+	}
+
 	typedef RandomInterpolator<Color> ColorRandomInterpolator;
 	typedef RandomInterpolator<float> FloatRandomInterpolator;
 
@@ -85,7 +104,7 @@ namespace SPK
 
 	template<typename T>
 	RandomInterpolator<T>::RandomInterpolator(const T& minBirthValue,const T& maxBirthValue,const T& minDeathValue,const T& maxDeathValue) :
-		Interpolator<T>(true),
+		Interpolator<T>(true,true),
 		minBirthValue(minBirthValue),
 		maxBirthValue(maxBirthValue),
 		minDeathValue(minDeathValue),
@@ -154,11 +173,17 @@ namespace SPK
 
 	template<typename T>
 	void RandomInterpolator<T>::interpolate(T* data,Group& group,DataSet* dataSet) const
+	{
+		interpolateChunk(data,group,dataSet,0,group.getNbParticles());
+	}
+
+	template<typename T>
+	void RandomInterpolator<T>::interpolateChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const
 	{
 		const ArrayData<T>& birthValuesData = SPK_GET_DATA(ArrayData<T>,dataSet,BIRTH_VALUE_DATA_INDEX);
 		const ArrayData<T>& deathValuesData = SPK_GET_DATA(ArrayData<T>,dataSet,DEATH_VALUE_DATA_INDEX);
 
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 		{
 			size_t index = particleIt->getIndex();
 			interpolateParam(data[index],deathValuesData[index],birthValuesData[index],particleIt->getEnergy());
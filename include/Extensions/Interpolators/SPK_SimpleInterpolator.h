@@ -22,6 +22,8 @@
 #ifndef H_SPK_SIMPLEINTERPOLATOR
 #define H_SPK_SIMPLEINTERPOLATOR
 
+#include <algorithm>
+
 namespace SPK
 {
 	template<typename T>
@@ -37,6 +39,8 @@ namespace SPK
 		Tv getBirthValue() const;
 		Tv getDeathValue() const;
 
+		virtual bool getBounds(T& min,T& max) const;
+
 	public :
 		spark_description(SimpleInterpolator, Interpolator)
 		(
@@ -52,9 +56,24 @@ namespace SPK
 		SimpleInterpolator<T>(const SimpleInterpolator<T>& interpolator);
 
 		virtual void interpolate(T* data,Group& group,DataSet* dataSet) const;
+		virtual void interpolateChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const;
 		virtual  void init(T& data,Particle& particle,DataSet* dataSet) const;
 	};
 
+	template<typename T>
+	inline bool SimpleInterpolator<T>::getBounds(T& min,T& max) const
+	{
+		return false;
+	}
+
+	template<>
+	inline bool SimpleInterpolator<float>::getBounds(float& min,float& max) const
+	{
+		min = std::min(birthValue,deathValue);
+		max = std::max(birthValue,deathValue);
+		return true;
+	}
+
 	typedef SimpleInterpolator<Color> ColorSimpleInterpolator;
 	typedef SimpleInterpolator<float> FloatSimpleInterpolator;
 
@@ -63,7 +82,7 @@ namespace SPK
 
 	template<typename T>
 	SimpleInterpolator<T>::SimpleInterpolator(Tv birthValue,Tv deathValue) :
-		Interpolator<T>(false),
+		Interpolator<T>(false,true),
 		birthValue(birthValue),
 		deathValue(deathValue)
 	{}
@@ -109,7 +128,13 @@ namespace SPK
 	template<typename T>
 	void SimpleInterpolator<T>::interpolate(T* data,Group& group,DataSet* dataSet) const
 	{
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		interpolateChunk(data,group,dataSet,0,group.getNbParticles());
+	}
+
+	template<typename T>
+	void SimpleInterpolator<T>::interpolateChunk(T* data,Group& group,DataSet* dataSet,size_t start,size_t end) const
+	{
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 			interpolateParam(data[particleIt->getIndex()],deathValue,birthValue,particleIt->getEnergy());
 	}
 }
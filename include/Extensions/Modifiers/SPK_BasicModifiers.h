@@ -34,6 +34,8 @@ namespace SPK
 		const Vector3D& getValue() const;
 		const Vector3D& getTransformedValue() const;
 
+		virtual float getMaxAcceleration(const Group& group) const;
+
 	public :
 		spark_description(Gravity, Modifier)
 		(
@@ -53,6 +55,7 @@ namespace SPK
 		Gravity(const Gravity& gravity);
 
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	class SPK_PREFIX Friction : public Modifier
@@ -64,6 +67,9 @@ namespace SPK
 		void setValue(float v) { value = v; }
 		float getValue() const { return value; }
 
+		// A positive friction only slows particles down
+		virtual float getMaxAcceleration(const Group& group) const { return value >= 0.0f ? 0.0f : std::numeric_limits<float>::infinity(); }
+
 		float value;
 
 	public :
@@ -78,10 +84,11 @@ namespace SPK
 		Friction(const Friction& friction);
 
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	inline Gravity::Gravity(const Vector3D& value) :
-		Modifier(MODIFIER_PRIORITY_FORCE,false,false,false)
+		Modifier(MODIFIER_PRIORITY_FORCE,false,false,false,true)
 	{
 		setValue(value);	
 	}
@@ -113,13 +120,18 @@ namespace SPK
 		return tValue;
 	}
 
+	inline float Gravity::getMaxAcceleration(const Group& group) const
+	{
+		return tValue.getNorm();
+	}
+
 	inline void Gravity::innerUpdateTransform()
 	{
 		transformDir(tValue,value);
 	}
 
 	inline Friction::Friction(float value) :
-		Modifier(MODIFIER_PRIORITY_FRICTION,false,false,false),
+		Modifier(MODIFIER_PRIORITY_FRICTION,false,false,false,true),
 		value(value)
 	{}
 
@@ -40,6 +40,17 @@ namespace SPK
 	* <li>An elasticity inferior to 0.0f has no sense and cannot be set</li>
 	* <li>To simulate collisions the elasticity will generally be set between ]0.0f,1.0f[ depending on the material of the particle</li>
 	* </ul>
+	* The neighbors of the particles are found with the SpatialIndex of the group.<br>
+	* <br>
+	* In parallel mode (see setParallel(bool)), the collisions are resolved in 2 passes split into jobs run by the TaskManager of the system :
+	* <ul>
+	* <li>Each particle tests all its neighbors and sums up its own response to every collision, from the state of the particles at the start of the pass.
+	* The distances to the neighbors are computed in SIMD over packed arrays of coordinates.</li>
+	* <li>The summed up responses are applied to the particles.</li>
+	* </ul>
+	* As the responses only depend on the state at the start of the pass and are summed up in a fixed order, the result is the same whatever the number of threads.
+	* The collisions of a particle are however resolved all at once instead of one after the other, which makes the result differ slightly from the serial mode.<br>
+	* <br>
 	* Note that collision particle vs particles requires intensive processing.
 	* Moreover the algorithm has a complexity that badly scales which means processing times increase fastly as particles count increase.<br>
 	* Tries to limitate the number of particles to perform collision on. More than 1000 particles can require a lot of processing time even of recent hardware.<br>
@@ -81,31 +92,73 @@ namespace SPK
 		*/
 		float getElasticity() const;
 
+		// Collisions only exchange speed between particles, the speed transferred is covered by the visibility margin of the system
+		virtual float getMaxAcceleration(const Group& group) const { return elasticity <= 1.0f ? 0.0f : std::numeric_limits<float>::infinity(); }
+
+		///////////////////
+		// Parallel mode //
+		///////////////////
+
+		/**
+		* @brief Sets whether the collisions are resolved in parallel
+		*
+		* See the class description for more information.<br>
+		* The parallel mode is meant for large groups. Without TaskManager in the system, the jobs are executed in the calling thread.
+		*
+		* @param parallel : true to resolve the collisions in parallel, false to resolve them one after the other
+		*/
+		void setParallel(bool parallel);
+
+		/**
+		* @brief Tells whether the collisions are resolved in parallel
+		* @return true if the collisions are resolved in parallel, false if not
+		*/
+		bool isParallel() const;
+
 	public :
 		spark_description(Collider, Modifier)
 		(
 			spk_attribute(float, elasticity, setElasticity, getElasticity);
+			spk_attribute(bool, parallel, setParallel, isParallel);
 		);
 
 	private :
 
+		class CollisionTask;
+
+		static const size_t NB_DATA = 2;
+		static const size_t VELOCITY_DELTA_INDEX = 0;
+		static const size_t RESET_INDEX = 1;
+
+		static const size_t COLLISION_JOB_SIZE = 1024;
+
 		float elasticity;
+		bool parallel;
 
 		Collider(float elasticity = 1.0f);
 		Collider(const Collider& collider);
 
+		virtual void createData(DataSet& dataSet,const Group& group) const;
+		virtual void checkData(DataSet& dataSet,const Group& group) const;
+
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+
+		void modifyParallel(Group& group,DataSet* dataSet) const;
+		void computeResponses(Group& group,DataSet* dataSet,size_t job) const;
+		void applyResponses(Group& group,DataSet* dataSet,size_t job) const;
 	};
 
 	inline Collider::Collider(float elasticity) :
-		Modifier(MODIFIER_PRIORITY_COLLISION,false,false,true)
+		Modifier(MODIFIER_PRIORITY_COLLISION,true,false,false,false,true),
+		parallel(false)
 	{
 		setElasticity(elasticity);
 	}
 
 	inline Collider::Collider(const Collider& collider) :
 		Modifier(collider),
-		elasticity(collider.elasticity)
+		elasticity(collider.elasticity),
+		parallel(collider.parallel)
 	{}
 
 	inline Ref<Collider> Collider::create(float elasticity)
@@ -117,6 +170,16 @@ namespace SPK
 	{
 		return elasticity;
 	}
+
+	inline void Collider::setParallel(bool parallel)
+	{
+		this->parallel = parallel;
+	}
+
+	inline bool Collider::isParallel() const
+	{
+		return parallel;
+	}
 }
 
 #endif
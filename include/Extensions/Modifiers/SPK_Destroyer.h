@@ -37,6 +37,8 @@ namespace SPK
 		*/
 		static  Ref<Destroyer> create(const Ref<Zone>& zone = SPK_NULL_REF,ZoneTest zoneTest = ZONE_TEST_INSIDE);
 
+		virtual float getMaxAcceleration(const Group& group) const { return 0.0f; }
+
 	public :
 		spark_description(Destroyer, ZonedModifier)
 		(
@@ -49,6 +51,7 @@ namespace SPK
 
 		virtual void init(Particle& particle,DataSet* dataSet) const;
 		virtual  void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual  void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	inline Ref<Destroyer> Destroyer::create(const Ref<Zone>& zone,ZoneTest zoneTest)
@@ -57,7 +60,7 @@ namespace SPK
 	}
 
 	inline Destroyer::Destroyer(const Ref<Zone>& zone,ZoneTest zoneTest) :
-		ZonedModifier(MODIFIER_PRIORITY_COLLISION,false,true,false,ZONE_TEST_FLAG_ALL & ~ZONE_TEST_FLAG_ALWAYS,zoneTest,zone)
+		ZonedModifier(MODIFIER_PRIORITY_COLLISION,false,true,false,ZONE_TEST_FLAG_ALL & ~ZONE_TEST_FLAG_ALWAYS,zoneTest,zone,true)
 	{}
 
 	inline Destroyer::Destroyer(const Destroyer& destroyer) :
@@ -72,7 +75,12 @@ namespace SPK
 
 	inline void Destroyer::modify(Group& group,DataSet* dataSet,float deltaTime) const
 	{
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		modifyChunk(group,dataSet,deltaTime,0,group.getNbParticles());
+	}
+
+	inline void Destroyer::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
+	{
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 			if (checkZone(*particleIt))
 				particleIt->kill();
 	}
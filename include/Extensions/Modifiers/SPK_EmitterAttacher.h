@@ -49,6 +49,13 @@ namespace SPK
 		bool isEmitterOrientationEnabled() const;
 		bool isEmitterRotationEnabled() const;
 
+		virtual float getMaxAcceleration(const Group& group) const { return 0.0f; }
+
+		// The target group belongs to the system
+		virtual bool isShareable() const { return false; }
+
+		virtual bool spawnsInto(const Group& group) const { return targetGroup.get() == &group; }
+
 	public :
 		spark_description(EmitterAttacher, Modifier)
 		(
@@ -91,6 +98,8 @@ namespace SPK
 			~EmitterData();
 
 			virtual void swap(size_t index0,size_t index1);
+			virtual bool resize(size_t capacity,size_t nbParticles);
+			virtual size_t getMemorySize() const;
 		};
 
 		Ref<Emitter> baseEmitter;
@@ -183,6 +192,11 @@ namespace SPK
 	{
 		SPK::swap(data[index0],data[index1]); // Calls the optimized swap of Ref instead of the std::swap
 	}
+
+	inline size_t EmitterAttacher::EmitterData::getMemorySize() const
+	{
+		return dataSize * sizeof(Ref<Emitter>); // The emitters themselves are not counted
+	}
 }
 
 #endif
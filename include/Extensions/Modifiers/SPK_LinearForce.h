@@ -224,6 +224,8 @@ namespace SPK
 		*/
 		float getCoef() const;
 
+		virtual float getMaxAcceleration(const Group& group) const;
+
 		//////////////
 		// Helpers //
 		/////////////
@@ -321,6 +323,7 @@ namespace SPK
 		float getDiscreteFactor(const Particle& particle) const;
 		
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	inline Ref<LinearForce> LinearForce::create(const Vector3D& value,const Ref<Zone>& zone,ZoneTest zoneTest)
@@ -72,6 +72,9 @@ namespace SPK
 		*/
 		float getFriction() const;
 
+		// A rebound does not make particles faster unless the ratios are greater than 1
+		virtual float getMaxAcceleration(const Group& group) const { return std::abs(bouncingRatio) <= 1.0f && std::abs(friction) <= 1.0f ? 0.0f : std::numeric_limits<float>::infinity(); }
+
 	public :
 		spark_description(Obstacle, ZonedModifier)
 		(
@@ -94,6 +97,7 @@ namespace SPK
 
 		virtual void init(Particle& particle,DataSet* dataSet) const;
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	inline Ref<Obstacle> Obstacle::create(const Ref<Zone>& zone,float bouncingRatio,float friction,ZoneTest zoneTest)
@@ -109,6 +109,8 @@ namespace SPK
 		*/
 		float getOffset() const;
 
+		virtual float getMaxAcceleration(const Group& group) const;
+
 	public :
 		spark_description(PointMass, Modifier)
 		(
@@ -133,6 +135,7 @@ namespace SPK
 		PointMass(const PointMass& pointMass);
 
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	inline Ref<PointMass> PointMass::create(const Vector3D& pos,float mass,float offset)
@@ -117,6 +117,8 @@ namespace SPK
 		*/
 		float getMaxPeriod() const;
 
+		virtual float getMaxAcceleration(const Group& group) const;
+
 	public :
 		spark_description(RandomForce, Modifier)
 		(
@@ -44,6 +44,8 @@ namespace SPK
 		*/
 		static  Ref<Rotator> create();
 
+		virtual float getMaxAcceleration(const Group& group) const { return 0.0f; }
+
 	public :
 		spark_description(Rotator, Modifier)
 		(
@@ -56,10 +58,11 @@ namespace SPK
 		Rotator(const Rotator& rotator);
 
 		virtual void modify(Group& group,DataSet* dataSet,float deltaTime) const;
+		virtual void modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const;
 	};
 
 	inline Rotator::Rotator() :
-		Modifier(MODIFIER_PRIORITY_POSITION,false,false,false)
+		Modifier(MODIFIER_PRIORITY_POSITION,false,false,false,true)
 	{}
 
 	inline Rotator::Rotator(const Rotator& rotator) :
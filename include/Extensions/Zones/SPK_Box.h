@@ -55,6 +55,7 @@ namespace SPK
 		virtual bool contains(const Vector3D& v,float radius = 0.0f) const;
 		virtual bool intersects(const Vector3D& v0,const Vector3D& v1,float radius = 0.0f,Vector3D* normal = NULL) const;
 		virtual Vector3D computeNormal(const Vector3D& v) const;
+		virtual void computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const;
 
 	public :
 		spark_description(Box, Zone)
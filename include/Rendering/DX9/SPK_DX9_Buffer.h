@@ -75,6 +75,8 @@ namespace DX9
 		// WARNING : draw call takes primitive number not vertex number
 		void render(D3DPRIMITIVETYPE primitive, size_t nbPrimitives);
 
+		virtual size_t getMemorySize() const;
+
 	private :
 
 		const size_t nbVertices;
@@ -205,6 +207,14 @@ namespace DX9
 		currentTexCoordIndex += nb;
 	}
 
+	inline size_t DX9Buffer::getMemorySize() const
+	{
+		size_t size = nbVertices * (sizeof(D3DXVECTOR3) + sizeof(D3DCOLOR)) + nbIndices * sizeof(short);
+		if (nbTexCoords > 0)
+			size += nbVertices * sizeof(D3DXVECTOR2);
+		return size;
+	}
+
 	inline size_t DX9Buffer::getNbTexCoords()
 	{
 		return nbTexCoords;
@@ -86,6 +86,10 @@ namespace scene
 
 		/**
 		* @brief Enables or disables update when the system is not visible
+		*
+		* When enabled, the system is not simulated while the node is not visible and catches up with the time elapsed
+		* when the node becomes visible again (see SPK::System::setVisible(bool)).
+		*
         * @param onlyWhenVisible : True to perform update only if node is visible
 		*/
 		void setUpdateOnlyWhenVisible(bool onlyWhenVisible);
@@ -55,6 +55,8 @@ namespace IRR
 
 		void setUsed(size_t nb);
 
+		virtual size_t getMemorySize() const;
+
 	private :
 
 		irr::scene::CDynamicMeshBuffer* meshBuffer;
@@ -75,6 +77,12 @@ namespace IRR
 		return nbParticles * nbVerticesPerParticle > 65536 ? irr::video::EIT_32BIT : irr::video::EIT_16BIT;
 	}
 
+	inline size_t IRRBuffer::getMemorySize() const
+	{
+		const size_t indexSize = getIndiceType() == irr::video::EIT_32BIT ? sizeof(irr::u32) : sizeof(irr::u16);
+		return nbParticles * (nbVerticesPerParticle * sizeof(irr::video::S3DVertex) + nbIndicesPerParticle * indexSize);
+	}
+
 	inline void IRRBuffer::positionAtStart()
 	{
 		currentIndexIndex = 0;
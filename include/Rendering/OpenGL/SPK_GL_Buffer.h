@@ -50,6 +50,8 @@ namespace GL
 
 		void render(GLuint primitive,size_t nbVertices);
 
+		virtual size_t getMemorySize() const;
+
 	private :
 
 		const size_t nbVertices;
@@ -100,6 +102,11 @@ namespace GL
 	{
 		return nbTexCoords;
 	}
+
+	inline size_t GLBuffer::getMemorySize() const
+	{
+		return nbVertices * (sizeof(Vector3D) + sizeof(Color) + nbTexCoords * sizeof(float));
+	}
 }}
 
 #endif
@@ -24,7 +24,10 @@
 
 #include "Core/SPK_DEF.h"
 #include "Core/SPK_Logger.h"
+#include "Core/SPK_TaskManager.h"
 #include "Core/SPK_Vector3D.h"
+#include "Core/SPK_Kernels.h"
+#include "Core/SPK_Frustum.h"
 #include "Core/SPK_Color.h"
 #include "Core/SPK_Meta.h"
 #include "Core/SPK_Types.h"
@@ -57,11 +60,17 @@
 #include "Core/SPK_ZonedModifier.h"
 #include "Core/SPK_Renderer.h"
 #include "Core/SPK_Action.h"
+#include "Core/SPK_Stats.h"
 #include "Core/SPK_System.h"
 #include "Core/SPK_Group.h"
 #include "Core/SPK_Particle.h"
 #include "Core/SPK_Iterator.h"
 #include "Core/SPK_Octree.h"
+#include "Core/SPK_SpatialIndex.h"
+#include "Core/SPK_NeighborQuery.h"
+#include "Core/SPK_SystemScheduler.h"
+#include "Core/SPK_SystemPool.h"
+#include "Core/SPK_BudgetManager.h"
 #include "Core/SPK_Factory.h"
 #include "Core/IO/SPK_IO_Loader.h"
 #include "Core/IO/SPK_IO_Saver.h"
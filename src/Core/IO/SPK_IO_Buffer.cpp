@@ -33,6 +33,7 @@ namespace IO
 		position(0)
 	{
 		buf = SPK_NEW_ARRAY(char, capacity);
+		SPK_TRACK_MEMORY(MEMORY_IO,capacity);
 	}
 
 	Buffer::Buffer(size_t capacity,std::istream& is) :
@@ -41,6 +42,7 @@ namespace IO
 		position(0)
 	{
 		buf = SPK_NEW_ARRAY(char,capacity);
+		SPK_TRACK_MEMORY(MEMORY_IO,capacity);
 		is.read(buf,capacity);
 		size = capacity;
 	}
@@ -48,6 +50,7 @@ namespace IO
 	Buffer::~Buffer()
 	{
 		SPK_DELETE_ARRAY(buf);
+		SPK_UNTRACK_MEMORY(MEMORY_IO,capacity);
 	}
 
 	const char* Buffer::get(size_t length) const
@@ -98,6 +101,7 @@ namespace IO
 			char* newBuf = SPK_NEW_ARRAY(char, newCapacity);
 			std::memcpy(newBuf, buf, size);
 			SPK_DELETE_ARRAY(buf);
+			SPK_TRACK_MEMORY(MEMORY_IO,newCapacity - capacity);
 			buf = newBuf;
 			capacity = newCapacity;
 		}
@@ -0,0 +1,205 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+	BudgetManager::BudgetManager() :
+		budget(0),
+		throttleThreshold(0.8f),
+		cullingEnabled(false),
+		nbParticles(0),
+		nbCulledParticles(0),
+		nbAvailableParticles(0)
+	{}
+
+	BudgetManager& BudgetManager::get()
+	{
+		static BudgetManager instance;
+		return instance;
+	}
+
+	void BudgetManager::setBudget(size_t budget)
+	{
+		this->budget = budget;
+		resetAvailableParticles();
+	}
+
+	void BudgetManager::setThrottleThreshold(float threshold)
+	{
+		throttleThreshold = std::min(1.0f,std::max(0.0f,threshold));
+	}
+
+	void BudgetManager::registerSystem(const Ref<System>& system,int priority)
+	{
+		if (!system)
+		{
+			SPK_LOG_WARNING("BudgetManager::registerSystem(const Ref<System>&,int) - The system to register is NULL");
+			return;
+		}
+
+		for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+			if (it->system == system.get())
+			{
+				it->priority = priority;
+				return;
+			}
+
+		Entry entry;
+		entry.system = system.get();
+		entry.priority = priority;
+		entries.push_back(entry);
+
+		system->budgetRegistered = true;
+	}
+
+	void BudgetManager::unregisterAllSystems()
+	{
+		for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+		{
+			it->system->budgetRegistered = false;
+			it->system->emissionScale = 1.0f;
+		}
+
+		entries.clear();
+	}
+
+	int BudgetManager::getPriority(const Ref<System>& system) const
+	{
+		for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+			if (it->system == system.get())
+				return it->priority;
+
+		return 0;
+	}
+
+	void BudgetManager::removeSystem(System* system)
+	{
+		for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+			if (it->system == system)
+			{
+				system->budgetRegistered = false;
+				system->emissionScale = 1.0f;
+				entries.erase(it);
+				return;
+			}
+	}
+
+	void BudgetManager::update()
+	{
+		// The stable sort keeps the registration order between systems of the same priority
+		std::stable_sort(entries.begin(),entries.end());
+
+		nbParticles = 0;
+		for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+			nbParticles += it->system->getNbParticles();
+
+		nbCulledParticles = 0;
+
+		if (budget == 0)
+		{
+			for (std::vector<Entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+				it->system->emissionScale = 1.0f;
+			return;
+		}
+
+		if (cullingEnabled && nbParticles > budget)
+			cullGroups();
+
+		resetAvailableParticles();
+
+		const float softBudget = budget * throttleThreshold;
+		const float throttleRange = budget - softBudget;
+
+		size_t nbHigherParticles = 0; // Particles of the systems with a higher priority
+		std::vector<Entry>::const_iterator tierBegin = entries.begin();
+		while (tierBegin != entries.end())
+		{
+			// Systems of a same priority are processed together so that they get the same scale
+			std::vector<Entry>::const_iterator tierEnd = tierBegin;
+			size_t nbTierParticles = nbHigherParticles;
+			while (tierEnd != entries.end() && tierEnd->priority == tierBegin->priority)
+			{
+				nbTierParticles += tierEnd->system->getNbParticles();
+				++tierEnd;
+			}
+
+			float scale;
+			if (nbTierParticles <= softBudget)
+				scale = 1.0f;
+			else if (throttleRange <= 0.0f || nbTierParticles >= budget)
+				scale = 0.0f;
+			else
+				scale = (budget - nbTierParticles) / throttleRange;
+
+			for (std::vector<Entry>::const_iterator it = tierBegin; it != tierEnd; ++it)
+				it->system->emissionScale = scale;
+
+			nbHigherParticles = nbTierParticles;
+			tierBegin = tierEnd;
+		}
+	}
+
+	void BudgetManager::resetAvailableParticles()
+	{
+		nbAvailableParticles = nbParticles < budget ? budget - nbParticles : 0;
+	}
+
+	size_t BudgetManager::acquireParticles(size_t nb)
+	{
+		if (budget == 0)
+			return nb;
+
+#ifdef SPK_NO_THREADS
+		nb = std::min(nb,nbAvailableParticles);
+		nbAvailableParticles -= nb;
+		return nb;
+#else
+		// Systems can be updated in parallel
+		size_t nbAvailable = nbAvailableParticles.load(std::memory_order_relaxed);
+		size_t nbAcquired;
+		do nbAcquired = std::min(nb,nbAvailable);
+		while (nbAcquired > 0 && !nbAvailableParticles.compare_exchange_weak(nbAvailable,nbAvailable - nbAcquired,std::memory_order_relaxed));
+		return nbAcquired;
+#endif
+	}
+
+	void BudgetManager::cullGroups()
+	{
+		// Groups are emptied from the lowest priority and from the last group of each system
+		for (std::vector<Entry>::const_reverse_iterator it = entries.rbegin(); it != entries.rend(); ++it)
+			for (size_t i = it->system->getNbGroups(); i > 0; --i)
+			{
+				if (nbParticles <= budget)
+					return;
+
+				const Ref<Group>& group = it->system->getGroup(i - 1);
+				const size_t nbGroupParticles = group->getNbParticles();
+				group->empty();
+
+				nbParticles -= nbGroupParticles;
+				nbCulledParticles += nbGroupParticles;
+			}
+	}
+}
@@ -20,7 +20,6 @@
 //////////////////////////////////////////////////////////////////////////////////
 
 #include <ctime>
-#include <limits>
 
 #include <SPARK.h>
 #include "Extensions/Zones/SPK_Point.h" // for default zone
@@ -32,6 +31,9 @@ namespace SPK
 	SPK_DEFINE_ENUM(InterpolationType, SPK_ENUM_INTERPOLATION_TYPE)
 	SPK_DEFINE_ENUM(ConnectionStatus, SPK_ENUM_CONNECTION_STATUS)
 
+	// The current random generator of each thread (NULL for the default one)
+	static SPK_THREAD_LOCAL RandomGenerator* currentRandomGenerator = NULL;
+
 	SPKContext& SPKContext::get()
 	{
 		static SPKContext instance;
@@ -40,18 +42,13 @@ namespace SPK
 
 	// This allows SPARK initialization at application start up
 	SPKContext::SPKContext() :
-		defaultZone()
+		defaultZone(),
+		defaultRandomGenerator(static_cast<unsigned int>(std::time(NULL)))
 	{
 		// Ensure MemoryTracer is created before the context, because it will be used in the destructor
 #ifdef SPK_TRACE_MEMORY
 		SPK::SPKMemoryTracer::get();
 #endif
-
-		// Inits the random seed
-		randomSeed = static_cast<unsigned int>(std::time(NULL));
-		// little tweak to ensure the randomSeed is uniformly distributed along all the range
-		for (size_t i = 0; i < 2; ++i)
-			randomSeed = generateRandom(static_cast<unsigned int>(1),std::numeric_limits<unsigned int>::max());
 	}
 
 	// This allows SPARK finalization at application exit
@@ -66,6 +63,18 @@ namespace SPK
 		defaultZone.reset();
 	}
 
+	RandomGenerator& SPKContext::getRandomGenerator()
+	{
+		return currentRandomGenerator != NULL ? *currentRandomGenerator : defaultRandomGenerator;
+	}
+
+	RandomGenerator* SPKContext::setCurrentRandomGenerator(RandomGenerator* generator)
+	{
+		RandomGenerator* previousGenerator = currentRandomGenerator;
+		currentRandomGenerator = generator;
+		return previousGenerator;
+	}
+
 	const Ref<Zone>& SPKContext::getDefaultZone()
 	{
 		if (!defaultZone)
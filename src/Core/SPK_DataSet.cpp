@@ -49,4 +49,23 @@ namespace SPK
 			setData(i,NULL);
 		initialized = false;
 	}
+
+	size_t DataSet::getMemorySize() const
+	{
+		size_t size = nbData * sizeof(Data*);
+		for (size_t i = 0; i < nbData; ++i)
+			if (dataArray[i] != NULL)
+				size += dataArray[i]->getMemorySize();
+		return size;
+	}
+
+	void DataSet::resize(size_t capacity,size_t nbParticles)
+	{
+		for (size_t i = 0; i < nbData; ++i)
+			if (dataArray[i] != NULL && !dataArray[i]->resize(capacity,nbParticles))
+			{
+				destroyAllData(); // The datahandler will create the data again
+				return;
+			}
+	}
 }
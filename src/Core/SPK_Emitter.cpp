@@ -100,10 +100,19 @@ namespace SPK
 			zone->updateTransform(this);
 	}
 
-	void Emitter::emit(Particle& particle) const
+	void Emitter::emitChunk(Group& group,size_t start,size_t end) const
 	{
-		zone->generatePosition(particle.position(),full,particle.getRadius());
-		generateVelocity(particle,SPK_RANDOM(forceMin,forceMax) / particle.getParam(PARAM_MASS));
+		for (size_t i = start; i < end; ++i)
+		{
+			Particle particle = group.getParticle(i);
+			zone->generatePosition(particle.position(),full,particle.getRadius());
+		}
+
+		for (size_t i = start; i < end; ++i)
+		{
+			Particle particle = group.getParticle(i);
+			generateVelocity(particle,SPK_RANDOM(forceMin,forceMax) / particle.getParam(PARAM_MASS));
+		}
 	}
 
 	Ref<SPKObject> Emitter::findByName(const std::string& name)
@@ -24,8 +24,59 @@
 
 #include <SPARK_Core.h>
 
+// Measures the time spent in a stage of the update since the start or the previous stage
+#ifdef SPK_PROFILING
+#define SPK_PROFILE_START(timer) StatsTimer timer;
+#define SPK_PROFILE_STAGE(timer,stage) { const float time = timer.lap(); if (profilingEnabled) stats.frame.stageTimes[stage] += time; }
+#define SPK_PROFILE_SKIP(timer) timer.lap();
+#else
+#define SPK_PROFILE_START(timer)
+#define SPK_PROFILE_STAGE(timer,stage)
+#define SPK_PROFILE_SKIP(timer)
+#endif
+
 namespace SPK
 {
+	// Executes a range of chunk safe update stages on a chunk of particles
+	class Group::UpdateChunkTask : public Task
+	{
+	public :
+
+		UpdateChunkTask(Group& group,size_t firstStage,size_t lastStage,float deltaTime) :
+			group(group),
+			firstStage(firstStage),
+			lastStage(lastStage),
+			deltaTime(deltaTime)
+		{}
+
+		virtual void execute(size_t jobIndex)
+		{
+			size_t start = jobIndex * group.chunkSize;
+			size_t end = std::min(start + group.chunkSize,group.particleData.nbParticles);
+
+			for (size_t i = firstStage; i < lastStage; ++i)
+			{
+#ifdef SPK_PROFILING
+				StatsTimer timer;
+#endif
+				group.executeUpdateStage(group.updateStages[i],deltaTime,start,end,true);
+#ifdef SPK_PROFILING
+				if (group.profilingEnabled)
+					group.stageTimes[jobIndex * group.updateStages.size() + i] += timer.getElapsedTime();
+#endif
+			}
+		}
+
+	private :
+
+		Group& group;
+		const size_t firstStage;
+		const size_t lastStage;
+		const float deltaTime;
+
+		UpdateChunkTask& operator=(const UpdateChunkTask&); // Not used
+	};
+
 	const float Group::DEFAULT_VALUES[NB_PARAMETERS] =
 	{
 		1.0f,	// PARAM_SCALE
@@ -35,10 +86,24 @@ namespace SPK
 		0.0f,	// PARAM_ROTATION_SPEED
 	};
 
+	const float Group::AUTO_CAPACITY_MARGIN = 1.25f;
+	const float Group::AUTO_CAPACITY_SHRINK_THRESHOLD = 0.5f;
+	const float Group::AUTO_CAPACITY_SHRINK_DELAY = 2.0f;
+
 	Group::Group(const Ref<System>& system,size_t capacity) :
 		Transformable(SHARE_POLICY_FALSE),
 		system(system.get()),
 		nbEnabledParameters(0),
+		chunkSize(DEFAULT_CHUNK_SIZE),
+		additionnalDataDirty(true),
+		randomGenerator(SPKContext::get().getRandomGenerator().next()),
+		autoCapacityEnabled(false),
+		minAutoCapacity(1),
+		maxAutoCapacity(std::numeric_limits<size_t>::max()),
+		lowUsageTime(0.0f),
+		lowUsagePeak(0),
+		highWaterMark(0),
+		nbLostParticles(0),
 		minLifeTime(1.0f),
 		maxLifeTime(1.0f),
 		immortal(false),
@@ -52,8 +117,18 @@ namespace SPK
 		nbBufferedParticles(0),
 		birthAction(),
 		deathAction(),
-		octree(NULL)
+		octree(NULL),
+		spatialIndex(NULL)
 	{
+#ifdef SPK_PROFILING
+		profilingEnabled = false;
+#endif
+
+#ifdef SPK_MEMORY_STATISTICS
+		for (size_t i = 0; i < MEMORY_ALL; ++i)
+			memorySizes[i] = 0;
+#endif
+
 		reallocate(capacity);
 	}
 
@@ -61,6 +136,16 @@ namespace SPK
 		Transformable(group),
 		system(NULL),
 		nbEnabledParameters(0),
+		chunkSize(group.chunkSize),
+		additionnalDataDirty(true),
+		randomGenerator(SPKContext::get().getRandomGenerator().next()),
+		autoCapacityEnabled(group.autoCapacityEnabled),
+		minAutoCapacity(group.minAutoCapacity),
+		maxAutoCapacity(group.maxAutoCapacity),
+		lowUsageTime(0.0f),
+		lowUsagePeak(0),
+		highWaterMark(0),
+		nbLostParticles(0),
 		minLifeTime(group.minLifeTime),
 		maxLifeTime(group.maxLifeTime),
 		immortal(group.immortal),
@@ -72,8 +157,18 @@ namespace SPK
 		graphicalRadius(group.graphicalRadius),
 		physicalRadius(group.physicalRadius),
 		nbBufferedParticles(0),
-		octree(NULL)
+		octree(NULL),
+		spatialIndex(NULL)
 	{
+#ifdef SPK_PROFILING
+		profilingEnabled = false;
+#endif
+
+#ifdef SPK_MEMORY_STATISTICS
+		for (size_t i = 0; i < MEMORY_ALL; ++i)
+			memorySizes[i] = 0;
+#endif
+
 		reallocate(group.getCapacity());
 
 		renderer.obj = group.copyChild(group.renderer.obj);
@@ -95,10 +190,21 @@ namespace SPK
 
 		birthAction = group.copyChild(group.birthAction);
 		deathAction = group.copyChild(group.deathAction);
+
+		// The parameters of the spatial index are kept
+		if (group.spatialIndex != NULL)
+		{
+			spatialIndex = SPK_NEW(SpatialIndex,*this);
+			spatialIndex->copyParameters(*group.spatialIndex);
+		}
 	}
 
 	Group::~Group()
 	{
+#ifdef SPK_MEMORY_STATISTICS
+		releaseMemoryStatistics();
+#endif
+
 		destroyAllAdditionnalData();
 
 		SPK_DELETE_ARRAY(particleData.positions);
@@ -114,6 +220,7 @@ namespace SPK
 			SPK_DELETE_ARRAY(particleData.parameters[i]);
 
 		SPK_DELETE(octree);
+		SPK_DELETE(spatialIndex);
 
 		emptyBufferedParticles();
 	}
@@ -146,8 +253,13 @@ namespace SPK
 		}
 	}
 
-	bool Group::updateParticles(float deltaTime)
+	bool Group::updateParticles(float deltaTime,bool display)
 	{
+		// Random draws made during the update use the generator of the group
+		RandomGenerator* previousGenerator = SPKContext::get().setCurrentRandomGenerator(&randomGenerator);
+
+		SPK_PROFILE_START(timer)
+
 		// Prepares the additionnal data
 		prepareAdditionnalData();
 
@@ -158,10 +270,13 @@ namespace SPK
 		bool hasAliveEmitters = false;
 		activeEmitters.clear();
 
+		// The emission is throttled by the budget manager
+		const float emissionScale = system != NULL ? system->getEmissionScale() : 1.0f;
+
 		for (std::vector<Ref<Emitter> >::const_iterator it = emitters.begin(); it != emitters.end(); ++it)
 			if ((*it)->isActive())
 			{
-				int nb = (*it)->updateTankFromTime(deltaTime);
+				int nb = (*it)->updateTankFromTime(deltaTime,emissionScale);
 				if (nb > 0)
 				{
 					activeEmitters.push_back(WeakEmitterPair(*it,nb));
@@ -174,45 +289,25 @@ namespace SPK
 		size_t emitterIndex = 0;
 		size_t nbBorn = nbAutoBorn + nbManualBorn;
 
-		// Updates the age of the particles function of the delta time
-		for (size_t i = 0; i < particleData.nbParticles; ++i)
-			particleData.ages[i] += deltaTime;
-
-		// Computes the energy of the particles (if they are not immortal)
-		if (!immortal)
-			for (size_t i = 0; i < particleData.nbParticles; ++i)
-				particleData.energies[i] = 1.0f - particleData.ages[i] / particleData.lifeTimes[i];
-
-		// Updates the position of particles function of their velocity
-		if (!still)
-			for (size_t i = 0; i < particleData.nbParticles; ++i)
-			{
-				particleData.oldPositions[i] = particleData.positions[i];
-				particleData.positions[i] += particleData.velocities[i] * deltaTime;
-			}
-
-		// Interpolates the parameters
-		if (colorInterpolator.obj)
-			colorInterpolator.obj->interpolate(particleData.colors,*this,colorInterpolator.dataSet);
-		for (size_t i = 0; i < nbEnabledParameters; ++i)
-		{
-			FloatInterpolatorDef& interpolator = paramInterpolators[enabledParamIndices[i]];
-			interpolator.obj->interpolate(particleData.parameters[enabledParamIndices[i]],*this,interpolator.dataSet);
-		}
+		SPK_PROFILE_STAGE(timer,PROFILE_STAGE_EMISSION)
 
-		// Updates the octree if one
-		if (octree != NULL)
-			octree->update();
+#ifdef SPK_PROFILING
+		if (profilingEnabled)
+			stats.frame.nbBytesTouched += static_cast<float>(particleData.nbParticles * getParticleSize());
+#endif
 
-		// Modifies the particles with specific active modifiers behavior
-		for (std::vector<WeakModifierDef>::const_iterator it = activeModifiers.begin(); it != activeModifiers.end(); ++it)
-			it->obj->modify(*this,it->dataSet,deltaTime);
+		// Integrates the particles, interpolates their parameters and modifies them
+		executeUpdateStages(deltaTime);
+		SPK_PROFILE_SKIP(timer) // The update stages are measured individually
 
 		// Updates the renderer data
-		if (renderer.obj)
+		if (display && renderer.obj)
 			renderer.obj->update(*this,renderer.dataSet);
 
-		// Checks dead particles and reinits or swaps
+		SPK_PROFILE_STAGE(timer,PROFILE_STAGE_RENDERER)
+
+		// Checks dead particles and marks them for removal
+		deadIndices.clear();
 		for (size_t i = 0; i < particleData.nbParticles; ++i)
 			if (particleData.energies[i] <= 0.0f)
 			{
@@ -223,40 +318,290 @@ namespace SPK
 					deathAction->apply(particle);
 				}
 
-				bool replaceDeadParticle = false;
-				while (!replaceDeadParticle && nbBorn > 0)
-				{
-					if (initParticle(i,emitterIndex,nbManualBorn))
-						replaceDeadParticle = true;
-					--nbBorn;
-				}
-
-				if (!replaceDeadParticle)
-				{
-					swapParticles(i,particleData.nbParticles - 1);
-					--particleData.nbParticles;
-					--i; // As we need to test the swapped particle
-				}
+				deadIndices.push_back(i);
 			}
 
-		// Emits new particles if some left
-		while (nbBorn > 0 && particleData.maxParticles - particleData.nbParticles > 0)
+#ifdef SPK_PROFILING
+		if (profilingEnabled)
+			stats.frame.nbDeadParticles += static_cast<float>(deadIndices.size());
+#endif
+
+		// Removes all the dead particles at once
+		if (!deadIndices.empty())
+			removeDeadParticles();
+
+		SPK_PROFILE_STAGE(timer,PROFILE_STAGE_DEATH)
+
+		// Emits new particles at the end of the group
+		if (autoCapacityEnabled && nbBorn > particleData.maxParticles - particleData.nbParticles)
+			growCapacity(particleData.nbParticles + nbBorn);
+
+		const size_t nbFitting = std::min(nbBorn,particleData.maxParticles - particleData.nbParticles);
+		const size_t nbEmitted = acquireBudget(nbFitting);
+		if (nbEmitted > 0)
+			initParticles(nbEmitted,emitterIndex,nbManualBorn);
+
+#ifdef SPK_PROFILING
+		if (profilingEnabled)
 		{
-			if (!initParticle(particleData.nbParticles++,emitterIndex,nbManualBorn))
-				--particleData.nbParticles;
-			--nbBorn;
+			stats.frame.nbBornParticles += static_cast<float>(nbEmitted);
+			stats.frame.nbBytesTouched += static_cast<float>(nbEmitted * getParticleSize());
 		}
+#endif
+
+		// Particles left could not be emitted by lack of capacity (those refused by the budget are not lost for the capacity)
+		nbLostParticles += nbBorn - nbFitting;
+		if (particleData.nbParticles > highWaterMark)
+			highWaterMark = particleData.nbParticles;
+
+		if (autoCapacityEnabled)
+			updateAutoCapacity(deltaTime);
 
+		SPK_PROFILE_STAGE(timer,PROFILE_STAGE_EMISSION)
+
+		if (display)
+			computeDistances();
+
+		SPK_PROFILE_STAGE(timer,PROFILE_STAGE_DISTANCES)
+
+		emptyBufferedParticles();
+
+#ifdef SPK_MEMORY_STATISTICS
+		updateMemoryStatistics();
+#endif
+
+		SPKContext::get().setCurrentRandomGenerator(previousGenerator);
+		return hasAliveEmitters || particleData.nbParticles > 0;
+	}
+
+	void Group::prepareDisplay()
+	{
+		if (renderer.obj)
+			renderer.obj->update(*this,renderer.dataSet);
+
+		computeDistances();
+	}
+
+	void Group::computeDistances()
+	{
 		// Computes the distance of particles from the camera
 		if (distanceComputationEnabled)
 		{
 			for (size_t i = 0; i < particleData.nbParticles; ++i)
 				particleData.sqrDists[i] = getSqrDist(particleData.positions[i],system->getCameraPosition());
 		}
+	}
 
-		emptyBufferedParticles();
+	void Group::setAutoCapacityLimits(size_t minCapacity,size_t maxCapacity)
+	{
+		if (minCapacity == 0)
+		{
+			SPK_LOG_WARNING("Group::setAutoCapacityLimits(size_t,size_t) - The minimum capacity must be at least 1 - 1 is used");
+			minCapacity = 1;
+		}
 
-		return hasAliveEmitters || particleData.nbParticles > 0;
+		if (minCapacity <= maxCapacity)
+		{
+			minAutoCapacity = minCapacity;
+			maxAutoCapacity = maxCapacity;
+		}
+		else
+		{
+			SPK_LOG_WARNING("Group::setAutoCapacityLimits(size_t,size_t) - minCapacity is higher than maxCapacity - Values are swapped");
+			minAutoCapacity = maxCapacity;
+			maxAutoCapacity = minCapacity;
+		}
+	}
+
+	size_t Group::estimateCapacity() const
+	{
+		float demand = 0.0f;
+		for (std::vector<Ref<Emitter> >::const_iterator it = emitters.begin(); it != emitters.end(); ++it)
+			if ((*it)->isActive())
+			{
+				float flow = (*it)->getFlow();
+				int maxTank = (*it)->getMaxTank();
+
+				// An infinite tank gives no estimate when it is emitted at once or never drained
+				float emitterDemand;
+				if (flow < 0.0f)
+					emitterDemand = maxTank >= 0 ? static_cast<float>(maxTank) : 0.0f; // The whole tank is emitted at once
+				else if (immortal)
+					emitterDemand = maxTank >= 0 ? static_cast<float>(maxTank) : 0.0f;
+				else
+				{
+					emitterDemand = flow * maxLifeTime;
+					if (maxTank >= 0 && emitterDemand > maxTank)
+						emitterDemand = static_cast<float>(maxTank);
+				}
+
+				demand += emitterDemand;
+			}
+
+		// The demand is clamped before the conversion so that it stays within the range of size_t
+		if (demand <= 0.0f)
+			return 0;
+		if (demand >= static_cast<float>(maxAutoCapacity))
+			return maxAutoCapacity;
+		return static_cast<size_t>(std::ceil(demand));
+	}
+
+	size_t Group::clampAutoCapacity(float capacity) const
+	{
+		if (capacity >= static_cast<float>(maxAutoCapacity))
+			return maxAutoCapacity;
+		return std::max(minAutoCapacity,static_cast<size_t>(capacity));
+	}
+
+	void Group::growCapacity(size_t nbNeeded)
+	{
+		size_t capacity = clampAutoCapacity(std::max(nbNeeded,estimateCapacity()) * AUTO_CAPACITY_MARGIN);
+		if (capacity > particleData.maxParticles)
+		{
+			SPK_LOG_DEBUG("Group " << this << " grows from " << particleData.maxParticles << " to " << capacity << " particles");
+			reallocate(capacity);
+		}
+
+		lowUsageTime = 0.0f;
+		lowUsagePeak = 0;
+	}
+
+	void Group::updateAutoCapacity(float deltaTime)
+	{
+		size_t nbParticles = particleData.nbParticles;
+		if (nbParticles < particleData.maxParticles * AUTO_CAPACITY_SHRINK_THRESHOLD && particleData.maxParticles > minAutoCapacity)
+		{
+			// The capacity shrinks only after a sustained period of low use to avoid oscillations
+			lowUsageTime += deltaTime;
+			lowUsagePeak = std::max(lowUsagePeak,nbParticles);
+
+			if (lowUsageTime >= AUTO_CAPACITY_SHRINK_DELAY)
+			{
+				size_t capacity = clampAutoCapacity(std::max(lowUsagePeak,estimateCapacity()) * AUTO_CAPACITY_MARGIN);
+				if (capacity < particleData.maxParticles)
+				{
+					SPK_LOG_DEBUG("Group " << this << " shrinks from " << particleData.maxParticles << " to " << capacity << " particles");
+					reallocate(capacity);
+				}
+
+				lowUsageTime = 0.0f;
+				lowUsagePeak = 0;
+			}
+		}
+		else
+		{
+			lowUsageTime = 0.0f;
+			lowUsagePeak = 0;
+		}
+	}
+
+	void Group::executeUpdateStages(float deltaTime)
+	{
+		TaskManager* taskManager = system->getTaskManager();
+		bool parallel = taskManager != NULL && particleData.nbParticles > chunkSize;
+		size_t nbChunks = (particleData.nbParticles + chunkSize - 1) / chunkSize;
+
+#ifdef SPK_PROFILING
+		const size_t nbTimedChunks = parallel ? nbChunks : 1;
+		if (profilingEnabled)
+			stageTimes.assign(updateStages.size() * nbTimedChunks,0.0f);
+#endif
+
+		size_t i = 0;
+		while (i < updateStages.size())
+			if (parallel && updateStages[i].chunkSafe)
+			{
+				// Consecutive chunk safe stages are executed in a row on each chunk
+				size_t last = i + 1;
+				while (last < updateStages.size() && updateStages[last].chunkSafe)
+					++last;
+
+				UpdateChunkTask task(*this,i,last,deltaTime);
+				taskManager->execute(task,nbChunks);
+				i = last;
+			}
+			else
+			{
+#ifdef SPK_PROFILING
+				StatsTimer timer;
+#endif
+				executeUpdateStage(updateStages[i],deltaTime,0,particleData.nbParticles,false);
+#ifdef SPK_PROFILING
+				if (profilingEnabled)
+					stageTimes[i] += timer.getElapsedTime();
+#endif
+				++i;
+			}
+
+#ifdef SPK_PROFILING
+		if (profilingEnabled)
+			collectStageTimes(nbTimedChunks);
+#endif
+	}
+
+	void Group::executeUpdateStage(const UpdateStage& stage,float deltaTime,size_t start,size_t end,bool chunked)
+	{
+		switch (stage.type)
+		{
+		case UPDATE_STAGE_INTEGRATION :
+			integrateParticles(deltaTime,start,end);
+			break;
+
+		case UPDATE_STAGE_COLOR_INTERPOLATOR :
+			if (chunked)
+				colorInterpolator.obj->interpolateChunk(particleData.colors,*this,colorInterpolator.dataSet,start,end);
+			else
+				colorInterpolator.obj->interpolate(particleData.colors,*this,colorInterpolator.dataSet);
+			break;
+
+		case UPDATE_STAGE_PARAM_INTERPOLATOR : {
+			FloatInterpolatorDef& interpolator = paramInterpolators[stage.index];
+			if (chunked)
+				interpolator.obj->interpolateChunk(particleData.parameters[stage.index],*this,interpolator.dataSet,start,end);
+			else
+				interpolator.obj->interpolate(particleData.parameters[stage.index],*this,interpolator.dataSet);
+			break; }
+
+		case UPDATE_STAGE_OCTREE :
+			octree->update();
+			break;
+
+		case UPDATE_STAGE_SPATIAL_INDEX :
+			spatialIndex->update(system->getTaskManager());
+			break;
+
+		case UPDATE_STAGE_MODIFIER : {
+			const WeakModifierDef& modifier = activeModifiers[stage.index];
+			if (chunked)
+				modifier.obj->modifyChunk(*this,modifier.dataSet,deltaTime,start,end);
+			else
+				modifier.obj->modify(*this,modifier.dataSet,deltaTime);
+			break; }
+		}
+	}
+
+	void Group::integrateParticles(float deltaTime,size_t start,size_t end)
+	{
+		// Arrays of Vector3D are integrated as flat streams of floats
+		typedef char VECTOR3D_MUST_BE_3_FLOATS[sizeof(Vector3D) == 3 * sizeof(float) ? 1 : -1];
+
+		size_t nb = end - start;
+
+		// Updates the age of the particles function of the delta time
+		kernelAdd(particleData.ages + start,deltaTime,nb);
+
+		// Computes the energy of the particles (if they are not immortal)
+		if (!immortal)
+			kernelComputeEnergies(particleData.energies + start,particleData.ages + start,particleData.lifeTimes + start,nb);
+
+		// Updates the position of particles function of their velocity
+		if (!still)
+			kernelIntegrate(
+				reinterpret_cast<float*>(particleData.positions + start),
+				reinterpret_cast<float*>(particleData.oldPositions + start),
+				reinterpret_cast<const float*>(particleData.velocities + start),
+				deltaTime,
+				nb * 3);
 	}
 
 	void Group::renderParticles()
@@ -266,7 +611,24 @@ namespace SPK
 			renderer.obj->prepareData(*this,renderer.dataSet);
 			if (renderer.renderBuffer == NULL)
 				renderer.renderBuffer = renderer.obj->attachRenderBuffer(*this);
+
+			// Positions are interpolated between the last 2 updates and swapped with the current ones while rendering
+			Vector3D* currentPositions = particleData.positions;
+			float ratio = system->getInterpolationRatio();
+			if (ratio < 1.0f && !still && particleData.nbParticles > 0)
+			{
+				renderPositions.resize(particleData.nbParticles);
+				kernelLerp(
+					reinterpret_cast<float*>(&renderPositions[0]),
+					reinterpret_cast<const float*>(particleData.oldPositions),
+					reinterpret_cast<const float*>(particleData.positions),
+					ratio,
+					particleData.nbParticles * 3);
+				particleData.positions = &renderPositions[0];
+			}
+
 			renderer.obj->render(*this,renderer.dataSet,renderer.renderBuffer);
+			particleData.positions = currentPositions;
 		}
 	}
 
@@ -274,25 +636,43 @@ namespace SPK
 	{
 		SPK_ASSERT(capacity != 0,"Group::reallocate(size_t) - Group capacity must not be 0");
 
-		if (isInitialized() && (!particleData.initialized || capacity != particleData.maxParticles))
+		if (isInitialized())
 		{
-			destroyAllAdditionnalData();
+			// Particles beyond the new capacity are lost
+			if (capacity < particleData.nbParticles)
+				particleData.nbParticles = capacity;
 
-			size_t copySize = particleData.nbParticles;
-			if (capacity < copySize)
-				copySize = capacity;
+			// The contiguous arrays are only reallocated when the capacity rounded up to the granularity changes
+			size_t nbAllocated = capacity;
+			if (capacity > CAPACITY_GRANULARITY)
+				nbAllocated = ((capacity + CAPACITY_GRANULARITY - 1) / CAPACITY_GRANULARITY) * CAPACITY_GRANULARITY;
 
-			reallocateArray(particleData.positions,capacity,copySize);
-			reallocateArray(particleData.velocities,capacity,copySize);
-			reallocateArray(particleData.oldPositions,capacity,copySize);
-			reallocateArray(particleData.ages,capacity,copySize);
-			reallocateArray(particleData.lifeTimes,capacity,copySize);
-			reallocateArray(particleData.energies,capacity,copySize);
-			reallocateArray(particleData.sqrDists,capacity,copySize);
-			reallocateArray(particleData.colors,capacity,copySize);
+			if (!particleData.initialized || nbAllocated != particleData.nbAllocated)
+			{
+				size_t copySize = particleData.nbParticles;
 
-			for (size_t i = 0; i < nbEnabledParameters; ++i)
-				reallocateArray(particleData.parameters[enabledParamIndices[i]],capacity,copySize);
+				reallocateArray(particleData.positions,nbAllocated,copySize);
+				reallocateArray(particleData.velocities,nbAllocated,copySize);
+				reallocateArray(particleData.oldPositions,nbAllocated,copySize);
+				reallocateArray(particleData.ages,nbAllocated,copySize);
+				reallocateArray(particleData.lifeTimes,nbAllocated,copySize);
+				reallocateArray(particleData.energies,nbAllocated,copySize);
+				reallocateArray(particleData.sqrDists,nbAllocated,copySize);
+				reallocateArray(particleData.colors,nbAllocated,copySize);
+
+				for (size_t i = 0; i < nbEnabledParameters; ++i)
+					reallocateArray(particleData.parameters[enabledParamIndices[i]],nbAllocated,copySize);
+
+				particleData.nbAllocated = nbAllocated;
+			}
+
+			// Additionnal data is resized and kept, render buffers are created again at next rendering
+			if (particleData.initialized && capacity != particleData.maxParticles)
+			{
+				destroyRenderBuffer();
+				for (std::list<DataSet>::iterator it = dataSets.begin(); it != dataSets.end(); ++it)
+					it->resize(capacity,particleData.nbParticles);
+			}
 
 			particleData.initialized = true;
 		}
@@ -321,7 +701,7 @@ namespace SPK
 
 				// Creates the data for the parameter
 				if (isInitialized())
-					particleData.parameters[param] = SPK_NEW_ARRAY(float,particleData.maxParticles);
+					particleData.parameters[param] = SPK_NEW_ARRAY(float,particleData.nbAllocated);
 			}
 			else if (paramInterpolators[param].obj && !interpolator)
 			{
@@ -460,101 +840,162 @@ namespace SPK
 				enabledParamIndices[nbEnabledParameters++] = i;
 	}
 
-	bool Group::initParticle(size_t index,size_t& emitterIndex,size_t& nbManualBorn)
+	void Group::initParticles(size_t nb,size_t& emitterIndex,size_t& nbManualBorn)
 	{
-		Particle particle(getParticle(index));
+		// The particles are born at the end of the group and are initialized pass by pass
+		const size_t start = particleData.nbParticles;
+		const size_t end = start + nb;
+		particleData.nbParticles = end;
 
-		particleData.ages[index] = 0.0f;
-		particleData.energies[index] = 1.0f;
-		particleData.lifeTimes[index] = SPK_RANDOM(minLifeTime,maxLifeTime);
+		// Life
+		std::fill(particleData.ages + start,particleData.ages + end,0.0f);
+		std::fill(particleData.energies + start,particleData.energies + end,1.0f);
+		SPKContext::get().getRandomGenerator().fill(particleData.lifeTimes + start,nb,minLifeTime,maxLifeTime);
 
+		// Color and parameters
 		if (colorInterpolator.obj)
-			colorInterpolator.obj->init(particleData.colors[index],particle,colorInterpolator.dataSet);
+			colorInterpolator.obj->initChunk(particleData.colors,*this,colorInterpolator.dataSet,start,end);
 		else
-			particleData.colors[index] = 0xFFFFFFFF;
+			std::fill(particleData.colors + start,particleData.colors + end,Color(0xFFFFFFFF));
 
 		for (size_t i = 0; i < nbEnabledParameters; ++i)
 		{
 			FloatInterpolatorDef& interpolator = paramInterpolators[enabledParamIndices[i]];
-			interpolator.obj->init(particleData.parameters[enabledParamIndices[i]][index],particle,interpolator.dataSet);
+			interpolator.obj->initChunk(particleData.parameters[enabledParamIndices[i]],*this,interpolator.dataSet,start,end);
 		}
 
-		if (nbManualBorn == 0)
-		{
-			activeEmitters[emitterIndex].obj->emit(particle);
-			if (--activeEmitters[emitterIndex].nbBorn == 0)
-				++emitterIndex;
-		}
-		else
+		// Positions and velocities, of the particles added manually first
+		size_t index = start;
+		while (index < end && nbManualBorn > 0)
 		{
 			CreationData& creationData = creationBuffer.front();
+			const size_t chunkEnd = std::min(end,index + creationData.nb);
 
 			if (creationData.zone)
-				creationData.zone->generatePosition(particle.position(),creationData.full,particle.getRadius());
+				for (size_t i = index; i < chunkEnd; ++i)
+				{
+					Particle particle = getParticle(i);
+					creationData.zone->generatePosition(particle.position(),creationData.full,particle.getRadius());
+				}
 			else
-				particle.position() = creationData.position;
+				std::fill(particleData.positions + index,particleData.positions + chunkEnd,creationData.position);
 
 			if (creationData.emitter)
-			{
-				float speed = SPK_RANDOM(creationData.emitter->getForceMin(),creationData.emitter->getForceMax()) / particle.getParam(PARAM_MASS);
-				creationData.emitter->generateVelocity(particle,speed);
-			}
+				for (size_t i = index; i < chunkEnd; ++i)
+				{
+					Particle particle = getParticle(i);
+					float speed = SPK_RANDOM(creationData.emitter->getForceMin(),creationData.emitter->getForceMax()) / particle.getParam(PARAM_MASS);
+					creationData.emitter->generateVelocity(particle,speed);
+				}
 			else
-				particle.velocity() = creationData.velocity;
+				std::fill(particleData.velocities + index,particleData.velocities + chunkEnd,creationData.velocity);
 
-			--creationBuffer.front().nb;
-			--nbManualBorn;
-			--nbBufferedParticles;
-			if (creationBuffer.front().nb <= 0)
+			const size_t nbCreated = chunkEnd - index;
+			creationData.nb -= nbCreated;
+			nbManualBorn -= nbCreated;
+			nbBufferedParticles -= nbCreated;
+			if (creationData.nb == 0)
 				creationBuffer.pop_front();
+
+			index = chunkEnd;
 		}
 
-		particleData.oldPositions[index] = particleData.positions[index];
+		while (index < end)
+		{
+			WeakEmitterPair& emitterPair = activeEmitters[emitterIndex];
+			const size_t chunkEnd = std::min(end,index + emitterPair.nbBorn);
+
+			emitterPair.obj->emitChunk(*this,index,chunkEnd);
+
+			emitterPair.nbBorn -= chunkEnd - index;
+			if (emitterPair.nbBorn == 0)
+				++emitterIndex;
+
+			index = chunkEnd;
+		}
+
+		std::copy(particleData.positions + start,particleData.positions + end,particleData.oldPositions + start);
 
 		for (std::vector<WeakModifierDef>::iterator it = initModifiers.begin(); it != initModifiers.end(); ++it)
-			it->obj->init(particle,it->dataSet);
+			it->obj->initChunk(*this,it->dataSet,start,end);
+
+		// Removes the particles killed at birth
+		deadIndices.clear();
+		for (size_t i = start; i < end; ++i)
+			if (particleData.energies[i] <= 0.0f)
+				deadIndices.push_back(i); // No birth neither death actions on born-dead particles
 
-		if (particle.isAlive())
+		if (!deadIndices.empty())
 		{
-			if (renderer.obj && renderer.obj->isActive())
-				renderer.obj->init(particle,renderer.dataSet);
+			SPK_LOG_DEBUG(deadIndices.size() << " particles of Group " << this << " are born-dead");
+			removeDeadParticles();
+		}
+
+		const size_t aliveEnd = particleData.nbParticles;
+
+		if (renderer.obj && renderer.obj->isActive())
+			renderer.obj->initChunk(*this,renderer.dataSet,start,aliveEnd);
 
-			// birth action
-			if (birthAction && birthAction->isActive())
+		// birth action
+		if (birthAction && birthAction->isActive())
+			for (size_t i = start; i < aliveEnd; ++i)
+			{
+				Particle particle = getParticle(i);
 				birthAction->apply(particle);
+			}
+	}
 
-			return true;
-		}
-		else
+	void Group::removeDeadParticles()
+	{
+		// The holes left by dead particles are filled with the last alive particles.
+		// Holes beyond the new number of particles are simply dropped
+		size_t newNbParticles = particleData.nbParticles - deadIndices.size();
+		size_t lastDead = deadIndices.size();
+		size_t source = particleData.nbParticles;
+
+		compactionSources.clear();
+		for (size_t i = 0; i < deadIndices.size() && deadIndices[i] < newNbParticles; ++i)
 		{
-			SPK_LOG_DEBUG("Particle " << index << " of Group " << this << " is born-dead");
-			return false; // No birth neither death actions on born-dead particles
+			--source;
+			while (lastDead > 0 && deadIndices[lastDead - 1] == source)
+			{
+				--lastDead;
+				--source;
+			}
+			compactionSources.push_back(source);
 		}
+
+		if (!compactionSources.empty())
+			compactParticles(&compactionSources[0],&deadIndices[0],compactionSources.size());
+
+		particleData.nbParticles = newNbParticles;
 	}
 
-	void Group::swapParticles(size_t index0,size_t index1)
+	void Group::compactParticles(const size_t* sources,const size_t* destinations,size_t nb)
 	{
-		// Swaps particles attributes
-		std::swap(particleData.positions[index0],particleData.positions[index1]);
-		std::swap(particleData.velocities[index0],particleData.velocities[index1]);
-		std::swap(particleData.oldPositions[index0],particleData.oldPositions[index1]);
-		std::swap(particleData.ages[index0],particleData.ages[index1]);
-		std::swap(particleData.energies[index0],particleData.energies[index1]);
-		std::swap(particleData.lifeTimes[index0],particleData.lifeTimes[index1]);
-		std::swap(particleData.sqrDists[index0],particleData.sqrDists[index1]);
-		std::swap(particleData.colors[index0],particleData.colors[index1]);
-
-		// Swaps particles enabled parameters
+		// Moves particles attributes
+		compactArray(particleData.positions,sources,destinations,nb);
+		compactArray(particleData.velocities,sources,destinations,nb);
+		compactArray(particleData.oldPositions,sources,destinations,nb);
+		compactArray(particleData.ages,sources,destinations,nb);
+		compactArray(particleData.energies,sources,destinations,nb);
+		compactArray(particleData.lifeTimes,sources,destinations,nb);
+		compactArray(particleData.sqrDists,sources,destinations,nb);
+		compactArray(particleData.colors,sources,destinations,nb);
+
+		// Moves particles enabled parameters
 		for (size_t i = 0; i < nbEnabledParameters; ++i)
-			std::swap(particleData.parameters[enabledParamIndices[i]][index0],particleData.parameters[enabledParamIndices[i]][index1]);
+			compactArray(particleData.parameters[enabledParamIndices[i]],sources,destinations,nb);
 
-		// Swaps particles additionnal swappable data
+		// Moves particles additionnal data
 		for (std::list<DataSet>::iterator it = dataSets.begin(); it != dataSets.end(); ++it)
-			it->swap(index0,index1);
+			it->compact(sources,destinations,nb);
 	}
 
 	DataSet* Group::attachDataSet(DataHandler* dataHandler)
 	{
+		additionnalDataDirty = true; // The handlers of the group changed
+
 		if (!isInitialized())
 			return NULL;
 
@@ -569,6 +1010,8 @@ namespace SPK
 
 	void Group::detachDataSet(DataSet* dataSet)
 	{
+		additionnalDataDirty = true; // The handlers of the group changed
+
 		if (dataSet != NULL)
 			for (std::list<DataSet>::iterator it = dataSets.begin(); it != dataSets.end(); ++it)
 				if (&*it == dataSet)
@@ -613,10 +1056,182 @@ namespace SPK
 		return octree;
 	}
 
+	void Group::manageSpatialIndexInstance(bool needsSpatialIndex)
+	{
+		if (needsSpatialIndex && spatialIndex == NULL) // creates a spatial index if needed
+			spatialIndex = SPK_NEW(SpatialIndex,*this);
+		else if (!needsSpatialIndex && spatialIndex != NULL) // deletes the spatial index if no more needed
+		{
+			SPK_DELETE(spatialIndex);
+			spatialIndex = NULL;
+		}
+	}
+
+	SpatialIndex* Group::getSpatialIndex()
+	{
+		bool needsSpatialIndex = false;
+		for (std::vector<WeakModifierDef>::const_iterator it = sortedModifiers.begin(); it != sortedModifiers.end(); ++it)
+			needsSpatialIndex |= it->obj->NEEDS_SPATIAL_INDEX;
+		manageSpatialIndexInstance(needsSpatialIndex);
+
+		return spatialIndex;
+	}
+
 	void Group::sortParticles()
 	{
-		if (sortingEnabled)
-			sortParticles(0,particleData.nbParticles - 1);
+		if (!sortingEnabled)
+		{
+			sortedIndices.clear();
+			return;
+		}
+
+		// Starts from the order of the previous frame as particles mostly keep their index and depth between frames.
+		// Indices of removed particles are dropped and new particles are added at the end
+		size_t nbParticles = particleData.nbParticles;
+		size_t previousNbParticles = sortedIndices.size();
+		if (nbParticles < previousNbParticles)
+		{
+			size_t nbKept = 0;
+			for (size_t i = 0; i < previousNbParticles; ++i)
+				if (sortedIndices[i] < nbParticles)
+					sortedIndices[nbKept++] = sortedIndices[i];
+			sortedIndices.resize(nbParticles);
+		}
+		else
+			for (size_t i = previousNbParticles; i < nbParticles; ++i)
+				sortedIndices.push_back(static_cast<unsigned int>(i));
+
+		// A nearly sorted order is fixed by an insertion sort. If too many particles moved, a radix sort is performed
+		if (!insertionSortParticles(nbParticles < SORT_INSERTION_THRESHOLD ? nbParticles * nbParticles : nbParticles))
+			radixSortParticles();
+	}
+
+	bool Group::getParamBounds(Param param,float& min,float& max) const
+	{
+		if (!paramInterpolators[param].obj)
+		{
+			min = max = DEFAULT_VALUES[param];
+			return true;
+		}
+
+		return paramInterpolators[param].obj->getBounds(min,max);
+	}
+
+	float Group::getMaxAcceleration() const
+	{
+		float maxAcceleration = 0.0f;
+		for (std::vector<ModifierDef>::const_iterator it = modifiers.begin(); it != modifiers.end(); ++it)
+			if (it->obj->isActive())
+				maxAcceleration += it->obj->getMaxAcceleration(*this);
+		return maxAcceleration;
+	}
+
+	size_t Group::acquireBudget(size_t nb) const
+	{
+		// Every particle born in a system registered in the budget manager is taken from the room left in the budget
+		if (nb > 0 && system != NULL && system->budgetRegistered)
+			return BudgetManager::get().acquireParticles(nb);
+		return nb;
+	}
+
+	bool Group::feeds(const Group& group) const
+	{
+		if ((birthAction && birthAction->spawnsInto(group)) || (deathAction && deathAction->spawnsInto(group)))
+			return true;
+
+		for (std::vector<ModifierDef>::const_iterator it = modifiers.begin(); it != modifiers.end(); ++it)
+			if (it->obj->spawnsInto(group))
+				return true;
+
+		return false;
+	}
+
+	void Group::computeParticleBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		if (particleData.nbParticles == 0)
+			return;
+
+		const float maxFloat = std::numeric_limits<float>::max();
+		const float maxAcceleration = getMaxAcceleration();
+
+		// Immortal particles and particles with an unbounded acceleration may go anywhere
+		if (immortal || maxAcceleration > maxFloat)
+		{
+			AABBMin.set(-maxFloat,-maxFloat,-maxFloat);
+			AABBMax.set(maxFloat,maxFloat,maxFloat);
+			return;
+		}
+
+		Vector3D particleMin(maxFloat,maxFloat,maxFloat);
+		Vector3D particleMax(-maxFloat,-maxFloat,-maxFloat);
+		float maxSqrSpeed = 0.0f;
+		float maxRemainingLife = 0.0f;
+
+		for (size_t i = 0; i < particleData.nbParticles; ++i)
+		{
+			particleMin.setMin(particleData.positions[i]);
+			particleMax.setMax(particleData.positions[i]);
+			maxSqrSpeed = std::max(maxSqrSpeed,particleData.velocities[i].getSqrNorm());
+			maxRemainingLife = std::max(maxRemainingLife,particleData.lifeTimes[i] - particleData.ages[i]);
+		}
+
+		// Distance a particle can travel before dying
+		const float reach = std::sqrt(maxSqrSpeed) * maxRemainingLife + 0.5f * maxAcceleration * maxRemainingLife * maxRemainingLife;
+		const Vector3D extent(reach,reach,reach);
+
+		AABBMin.setMin(particleMin - extent);
+		AABBMax.setMax(particleMax + extent);
+	}
+
+	void Group::computeEmissionBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		const float maxFloat = std::numeric_limits<float>::max();
+
+		bool emitting = false;
+		for (std::vector<Ref<Emitter> >::const_iterator it = emitters.begin(); it != emitters.end() && !emitting; ++it)
+			emitting = (*it)->isActive() && (*it)->getCurrentTank() != 0;
+
+		if (!emitting && nbBufferedParticles == 0)
+			return;
+
+		const float maxAcceleration = getMaxAcceleration();
+
+		// The speed given by emitters is bounded by the lightest particle
+		float minMass = 0.0f;
+		float maxMass = 0.0f;
+		const bool massBounded = getParamBounds(PARAM_MASS,minMass,maxMass) && minMass > 0.0f;
+
+		// Particles added manually may be anywhere and immortal particles may go anywhere
+		if (nbBufferedParticles > 0 || immortal || maxAcceleration > maxFloat || !massBounded)
+		{
+			AABBMin.set(-maxFloat,-maxFloat,-maxFloat);
+			AABBMax.set(maxFloat,maxFloat,maxFloat);
+			return;
+		}
+
+		for (std::vector<Ref<Emitter> >::const_iterator it = emitters.begin(); it != emitters.end(); ++it)
+			if ((*it)->isActive() && (*it)->getCurrentTank() != 0)
+			{
+				Vector3D zoneMin,zoneMax;
+				(*it)->getZone()->computeBounds(zoneMin,zoneMax);
+
+				const float speed = std::abs((*it)->getForceMax()) / minMass;
+				const float reach = speed * maxLifeTime + 0.5f * maxAcceleration * maxLifeTime * maxLifeTime;
+				const Vector3D extent(reach,reach,reach);
+
+				AABBMin.setMin(zoneMin - extent);
+				AABBMax.setMax(zoneMax + extent);
+			}
+	}
+
+	void Group::skipTime(float deltaTime)
+	{
+		// All the particles die within the time skipped
+		particleData.nbParticles = 0;
+
+		for (std::vector<Ref<Emitter> >::const_iterator it = emitters.begin(); it != emitters.end(); ++it)
+			if ((*it)->isActive())
+				(*it)->updateTankFromTime(deltaTime);
 	}
 
 	void Group::computeAABB()
@@ -638,28 +1253,90 @@ namespace SPK
 			}
 	}
 
-	void Group::sortParticles(int start,int end)
+	bool Group::insertionSortParticles(size_t maxShifts)
 	{
-		// quick sort implementation (can be optimized)
-		if (start < end)
+		const float* sqrDists = particleData.sqrDists;
+		size_t nbShifts = 0;
+
+		for (size_t i = 1; i < sortedIndices.size(); ++i)
 		{
-			int i = start - 1;
-			int j = end + 1;
-			float pivot = particleData.sqrDists[(start + end) >> 1];
-			while (true)
+			unsigned int index = sortedIndices[i];
+			float sqrDist = sqrDists[index];
+			size_t j = i;
+			while (j > 0 && sqrDists[sortedIndices[j - 1]] < sqrDist)
 			{
-				do ++i;
-				while (particleData.sqrDists[i] > pivot);
-				do --j;
-				while (particleData.sqrDists[j] < pivot);
-				if (i < j)
-					swapParticles(i,j);
-				else break;
+				sortedIndices[j] = sortedIndices[j - 1];
+				--j;
+				if (++nbShifts > maxShifts)
+				{
+					sortedIndices[j] = index; // Keeps a valid permutation
+					return false;
+				}
 			}
+			sortedIndices[j] = index;
+		}
+
+		return true;
+	}
 
-			sortParticles(start,j);
-			sortParticles(j + 1,end);
+	void Group::radixSortParticles()
+	{
+		const size_t RADIX_BITS = 11;
+		const size_t RADIX_SIZE = 1 << RADIX_BITS;
+		const size_t NB_PASSES = 3;
+
+		size_t nbParticles = sortedIndices.size();
+		sortBuffer.resize(nbParticles * 3);
+		unsigned int* keys = &sortBuffer[0];
+		unsigned int* tmpKeys = keys + nbParticles;
+		unsigned int* tmpIndices = tmpKeys + nbParticles;
+		unsigned int* indices = &sortedIndices[0];
+
+		// Converts the distances into keys whose ascending order is the descending order of the distances
+		size_t histograms[NB_PASSES][RADIX_SIZE];
+		std::memset(histograms,0,sizeof(histograms));
+
+		for (size_t i = 0; i < nbParticles; ++i)
+		{
+			unsigned int bits;
+			std::memcpy(&bits,particleData.sqrDists + indices[i],sizeof(float));
+			bits = (bits & 0x80000000) ? ~bits : (bits | 0x80000000); // Orders floats as unsigned integers
+			keys[i] = ~bits;
+
+			for (size_t pass = 0; pass < NB_PASSES; ++pass)
+				++histograms[pass][(keys[i] >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)];
 		}
+
+		// Least significant digit first, each pass being stable
+		for (size_t pass = 0; pass < NB_PASSES; ++pass)
+		{
+			size_t* histogram = histograms[pass];
+			size_t shift = pass * RADIX_BITS;
+
+			if (histogram[(keys[0] >> shift) & (RADIX_SIZE - 1)] == nbParticles)
+				continue; // All the keys share this digit
+
+			size_t offset = 0;
+			for (size_t i = 0; i < RADIX_SIZE; ++i)
+			{
+				size_t count = histogram[i];
+				histogram[i] = offset;
+				offset += count;
+			}
+
+			for (size_t i = 0; i < nbParticles; ++i)
+			{
+				size_t destination = histogram[(keys[i] >> shift) & (RADIX_SIZE - 1)]++;
+				tmpKeys[destination] = keys[i];
+				tmpIndices[destination] = indices[i];
+			}
+
+			std::swap(keys,tmpKeys);
+			std::swap(indices,tmpIndices);
+		}
+
+		if (indices != &sortedIndices[0])
+			std::memcpy(&sortedIndices[0],indices,nbParticles * sizeof(unsigned int));
 	}
 
 	void Group::propagateUpdateTransform()
@@ -764,8 +1441,15 @@ namespace SPK
 
 		SPK_ASSERT(isInitialized(),"Group::addParticles(unsigned int,const Vector3D&,const Vector3D&,Zone*,Emitter*,bool) - Particles cannot be added to an uninitialized group");
 
-		CreationData data = {nb,position,velocity,zone,emitter,full};
-		creationBuffer.push_back(data);
+		// The data is filled in place to avoid copying the references twice
+		creationBuffer.push_back(CreationData());
+		CreationData& data = creationBuffer.back();
+		data.nb = nb;
+		data.position = position;
+		data.velocity = velocity;
+		data.zone = zone;
+		data.emitter = emitter;
+		data.full = full;
 		nbBufferedParticles += nb;
 	}
 
@@ -774,16 +1458,24 @@ namespace SPK
 		if (nbBufferedParticles == 0)
 			return;
 
+		RandomGenerator* previousGenerator = SPKContext::get().setCurrentRandomGenerator(&randomGenerator);
+
 		prepareAdditionnalData();
 
 		size_t nbManualBorn = nbBufferedParticles;
 
-		size_t dummy;
-		while (nbManualBorn > 0 && particleData.maxParticles - particleData.nbParticles > 0)
-			if (!initParticle(particleData.nbParticles++,dummy,nbManualBorn))
-				--particleData.nbParticles;
+		size_t dummy = 0;
+		size_t nbEmitted = acquireBudget(std::min(nbManualBorn,particleData.maxParticles - particleData.nbParticles));
+		if (nbEmitted > 0)
+			initParticles(nbEmitted,dummy,nbManualBorn);
 
 		emptyBufferedParticles();
+		SPKContext::get().setCurrentRandomGenerator(previousGenerator);
+	}
+
+	TaskManager* Group::getTaskManager() const
+	{
+		return system != NULL ? system->getTaskManager() : NULL;
 	}
 
 	void Group::emptyBufferedParticles()
@@ -792,35 +1484,209 @@ namespace SPK
 		nbBufferedParticles = 0;
 	}
 
+	size_t Group::getParticleSize() const
+	{
+		// Positions, velocities and old positions, ages, life times, energies and distances, colors and enabled parameters
+		return 3 * sizeof(Vector3D) + 4 * sizeof(float) + sizeof(Color) + nbEnabledParameters * sizeof(float);
+	}
+
+#ifdef SPK_PROFILING
+	void Group::beginStatsFrame(bool profiling)
+	{
+		profilingEnabled = profiling;
+		stats.frame.clear();
+		for (std::vector<HandlerStats>::iterator it = stats.handlers.begin(); it != stats.handlers.end(); ++it)
+			it->time = 0.0f;
+	}
+
+	void Group::endStatsFrame(float averageWeight)
+	{
+		stats.frame.nbParticles = static_cast<float>(particleData.nbParticles);
+
+		if (stats.nbFrames == 0)
+			stats.average = stats.frame;
+		else
+			stats.average.blend(stats.frame,averageWeight);
+
+		for (std::vector<HandlerStats>::iterator it = stats.handlers.begin(); it != stats.handlers.end(); ++it)
+			it->averageTime += (it->time - it->averageTime) * averageWeight;
+
+		++stats.nbFrames;
+		profilingEnabled = false;
+	}
+
+	void Group::collectStageTimes(size_t nbChunks)
+	{
+		const size_t nbStages = updateStages.size();
+		for (size_t i = 0; i < nbStages; ++i)
+		{
+			float time = 0.0f;
+			for (size_t j = 0; j < nbChunks; ++j)
+				time += stageTimes[j * nbStages + i];
+
+			const UpdateStage& stage = updateStages[i];
+			switch (stage.type)
+			{
+			case UPDATE_STAGE_INTEGRATION :
+				stats.frame.stageTimes[PROFILE_STAGE_INTEGRATION] += time;
+				break;
+
+			case UPDATE_STAGE_COLOR_INTERPOLATOR :
+				stats.frame.stageTimes[PROFILE_STAGE_INTERPOLATION] += time;
+				stats.addHandlerTime(colorInterpolator.obj.get(),time);
+				break;
+
+			case UPDATE_STAGE_PARAM_INTERPOLATOR :
+				stats.frame.stageTimes[PROFILE_STAGE_INTERPOLATION] += time;
+				stats.addHandlerTime(paramInterpolators[stage.index].obj.get(),time);
+				break;
+
+			case UPDATE_STAGE_OCTREE :
+			case UPDATE_STAGE_SPATIAL_INDEX :
+				stats.frame.stageTimes[PROFILE_STAGE_OCTREE] += time;
+				break;
+
+			case UPDATE_STAGE_MODIFIER :
+				stats.frame.stageTimes[PROFILE_STAGE_MODIFIERS] += time;
+				stats.addHandlerTime(activeModifiers[stage.index].obj,time);
+				break;
+			}
+		}
+	}
+#endif
+
+#ifdef SPK_MEMORY_STATISTICS
+	void Group::updateMemoryStatistics()
+	{
+		// The memory is measured rather than counted at each allocation, which keeps the allocations untouched
+		setMemorySize(MEMORY_PARTICLES,
+			particleData.nbAllocated * getParticleSize() +
+			(deadIndices.capacity() + compactionSources.capacity()) * sizeof(size_t) +
+			renderPositions.capacity() * sizeof(Vector3D) +
+			(sortedIndices.capacity() + sortBuffer.capacity()) * sizeof(unsigned int));
+
+		size_t dataSetsSize = 0;
+		for (std::list<DataSet>::const_iterator it = dataSets.begin(); it != dataSets.end(); ++it)
+			dataSetsSize += it->getMemorySize();
+		setMemorySize(MEMORY_DATASETS,dataSetsSize);
+
+		setMemorySize(MEMORY_RENDER_BUFFERS,renderer.renderBuffer != NULL ? renderer.renderBuffer->getMemorySize() : 0);
+		setMemorySize(MEMORY_OCTREE,
+			(octree != NULL ? octree->getMemorySize() : 0) +
+			(spatialIndex != NULL ? spatialIndex->getMemorySize() : 0));
+	}
+
+	void Group::setMemorySize(MemoryCategory category,size_t size)
+	{
+		size_t& currentSize = memorySizes[category];
+		if (size > currentSize)
+		{
+			MemoryStatistics::get().allocate(category,size - currentSize);
+			if (system != NULL)
+				system->memoryStatistics.allocate(category,size - currentSize);
+		}
+		else if (size < currentSize)
+		{
+			MemoryStatistics::get().deallocate(category,currentSize - size);
+			if (system != NULL)
+				system->memoryStatistics.deallocate(category,currentSize - size);
+		}
+
+		currentSize = size;
+	}
+
+	void Group::releaseMemoryStatistics()
+	{
+		for (size_t i = 0; i < MEMORY_ALL; ++i)
+			setMemorySize(static_cast<MemoryCategory>(i),0);
+	}
+#endif
+
 	inline void Group::prepareAdditionnalData()
 	{
+		// Modifiers can be activated or deactivated without the group being notified
+		if (!additionnalDataDirty)
+		{
+			size_t activeIndex = 0;
+			for (std::vector<WeakModifierDef>::const_iterator it = sortedModifiers.begin(); it != sortedModifiers.end(); ++it)
+			{
+				bool wasActive = activeIndex < activeModifiers.size() && activeModifiers[activeIndex].obj == it->obj;
+				if (wasActive)
+					++activeIndex;
+				if (wasActive != it->obj->isActive())
+				{
+					additionnalDataDirty = true;
+					break;
+				}
+			}
+		}
+
+		// Nothing changed, only the data sets are checked as their handlers may have been modified
+		if (!additionnalDataDirty)
+		{
+			for (std::vector<PreparedDataHandler>::const_iterator it = preparedDataHandlers.begin(); it != preparedDataHandlers.end(); ++it)
+				it->first->prepareData(*this,it->second);
+			return;
+		}
+
+		additionnalDataDirty = false;
+		preparedDataHandlers.clear();
+
+#ifdef SPK_PROFILING
+		stats.handlers.clear(); // Handlers may have been removed
+#endif
+
 		if (renderer.obj)
-			renderer.obj->prepareData(*this,renderer.dataSet);
+			prepareDataHandler(renderer.obj.get(),renderer.dataSet);
 
 		activeModifiers.clear();
 		initModifiers.clear();
 
 		bool needsOctree = false;
+		bool needsSpatialIndex = false;
 		for (std::vector<WeakModifierDef>::const_iterator it = sortedModifiers.begin(); it != sortedModifiers.end(); ++it)
 		{
-			it->obj->prepareData(*this,it->dataSet);	// if it has a data set, it is prepared
+			prepareDataHandler(it->obj,it->dataSet);	// if it has a data set, it is prepared
 			if (it->obj->CALL_INIT)
 				initModifiers.push_back(*it); // if its init method needs to be called it is added to the init vector
 			if (it->obj->isActive())
 				activeModifiers.push_back(*it); // if the modifier is active, it is added to the active vector
 			needsOctree |= it->obj->NEEDS_OCTREE;
+			needsSpatialIndex |= it->obj->NEEDS_SPATIAL_INDEX;
 		}
 
 		manageOctreeInstance(needsOctree);
+		manageSpatialIndexInstance(needsSpatialIndex);
 
 		if (colorInterpolator.obj)
-			colorInterpolator.obj->prepareData(*this,colorInterpolator.dataSet);
+			prepareDataHandler(colorInterpolator.obj.get(),colorInterpolator.dataSet);
 
 		for (size_t i = 0; i < nbEnabledParameters; ++i)
 		{
 			FloatInterpolatorDef& interpolator = paramInterpolators[enabledParamIndices[i]];
-			interpolator.obj->prepareData(*this,interpolator.dataSet);
+			prepareDataHandler(interpolator.obj.get(),interpolator.dataSet);
 		}
+
+		// Builds the ordered list of update stages
+		updateStages.clear();
+		updateStages.push_back(UpdateStage(UPDATE_STAGE_INTEGRATION,0,true));
+		if (colorInterpolator.obj)
+			updateStages.push_back(UpdateStage(UPDATE_STAGE_COLOR_INTERPOLATOR,0,colorInterpolator.obj->isChunkSafe()));
+		for (size_t i = 0; i < nbEnabledParameters; ++i)
+			updateStages.push_back(UpdateStage(UPDATE_STAGE_PARAM_INTERPOLATOR,enabledParamIndices[i],paramInterpolators[enabledParamIndices[i]].obj->isChunkSafe()));
+		if (octree != NULL)
+			updateStages.push_back(UpdateStage(UPDATE_STAGE_OCTREE,0,false));
+		if (spatialIndex != NULL)
+			updateStages.push_back(UpdateStage(UPDATE_STAGE_SPATIAL_INDEX,0,false));
+		for (size_t i = 0; i < activeModifiers.size(); ++i)
+			updateStages.push_back(UpdateStage(UPDATE_STAGE_MODIFIER,i,activeModifiers[i].obj->isChunkSafe()));
+	}
+
+	inline void Group::prepareDataHandler(const DataHandler* dataHandler,DataSet* dataSet)
+	{
+		dataHandler->prepareData(*this,dataSet);
+		if (dataSet != NULL)
+			preparedDataHandlers.push_back(PreparedDataHandler(dataHandler,dataSet));
 	}
 
 	void Group::initData()
@@ -868,6 +1734,16 @@ namespace SPK
 		return NULL;
 	}
 
+	void Group::setChunkSize(size_t chunkSize)
+	{
+		if (chunkSize == 0)
+		{
+			chunkSize = 1;
+			SPK_LOG_WARNING("Group::setChunkSize(size_t) - The chunk size cannot be 0 - 1 is used");
+		}
+		this->chunkSize = chunkSize;
+	}
+
 	void Group::setGraphicalRadius(float radius)
 	{
 		if (radius < 0)
@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPK_NO_SIMD
+#if defined(__AVX__)
+#define SPK_SIMD_AVX
+#include <immintrin.h>
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SPK_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SPK_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#include <SPARK_Core.h>
+
+// Loads and stores are unaligned as particle arrays are only guaranteed to be aligned on the alignment of new[].
+// On recent hardware, unaligned accesses on aligned data cost the same as aligned ones.
+#if defined(SPK_SIMD_AVX)
+#define SPK_SIMD_WIDTH 8
+#define SPK_SIMD_TYPE __m256
+#define SPK_SIMD_SET(f) _mm256_set1_ps(f)
+#define SPK_SIMD_LOAD(p) _mm256_loadu_ps(p)
+#define SPK_SIMD_STORE(p,v) _mm256_storeu_ps(p,v)
+#define SPK_SIMD_ADD(a,b) _mm256_add_ps(a,b)
+#define SPK_SIMD_SUB(a,b) _mm256_sub_ps(a,b)
+#define SPK_SIMD_MUL(a,b) _mm256_mul_ps(a,b)
+#define SPK_SIMD_DIV(a,b) _mm256_div_ps(a,b)
+#elif defined(SPK_SIMD_SSE)
+#define SPK_SIMD_WIDTH 4
+#define SPK_SIMD_TYPE __m128
+#define SPK_SIMD_SET(f) _mm_set1_ps(f)
+#define SPK_SIMD_LOAD(p) _mm_loadu_ps(p)
+#define SPK_SIMD_STORE(p,v) _mm_storeu_ps(p,v)
+#define SPK_SIMD_ADD(a,b) _mm_add_ps(a,b)
+#define SPK_SIMD_SUB(a,b) _mm_sub_ps(a,b)
+#define SPK_SIMD_MUL(a,b) _mm_mul_ps(a,b)
+#define SPK_SIMD_DIV(a,b) _mm_div_ps(a,b)
+#elif defined(SPK_SIMD_NEON)
+#define SPK_SIMD_WIDTH 4
+#define SPK_SIMD_TYPE float32x4_t
+#define SPK_SIMD_SET(f) vdupq_n_f32(f)
+#define SPK_SIMD_LOAD(p) vld1q_f32(p)
+#define SPK_SIMD_STORE(p,v) vst1q_f32(p,v)
+#define SPK_SIMD_ADD(a,b) vaddq_f32(a,b)
+#define SPK_SIMD_SUB(a,b) vsubq_f32(a,b)
+#define SPK_SIMD_MUL(a,b) vmulq_f32(a,b)
+#if defined(__aarch64__)
+#define SPK_SIMD_DIV(a,b) vdivq_f32(a,b)
+#endif
+#else
+#define SPK_SIMD_WIDTH 1
+#endif
+
+namespace SPK
+{
+	void kernelAdd(float* data,float value,size_t nb)
+	{
+		size_t i = 0;
+#if SPK_SIMD_WIDTH > 1
+		const SPK_SIMD_TYPE v = SPK_SIMD_SET(value);
+		for (; i + SPK_SIMD_WIDTH <= nb; i += SPK_SIMD_WIDTH)
+			SPK_SIMD_STORE(data + i,SPK_SIMD_ADD(SPK_SIMD_LOAD(data + i),v));
+#endif
+		for (; i < nb; ++i)
+			data[i] += value;
+	}
+
+	void kernelComputeEnergies(float* energies,const float* ages,const float* lifeTimes,size_t nb)
+	{
+		size_t i = 0;
+#if SPK_SIMD_WIDTH > 1 && defined(SPK_SIMD_DIV)
+		const SPK_SIMD_TYPE one = SPK_SIMD_SET(1.0f);
+		for (; i + SPK_SIMD_WIDTH <= nb; i += SPK_SIMD_WIDTH)
+			SPK_SIMD_STORE(energies + i,SPK_SIMD_SUB(one,SPK_SIMD_DIV(SPK_SIMD_LOAD(ages + i),SPK_SIMD_LOAD(lifeTimes + i))));
+#endif
+		for (; i < nb; ++i)
+			energies[i] = 1.0f - ages[i] / lifeTimes[i];
+	}
+
+	void kernelIntegrate(float* positions,float* oldPositions,const float* velocities,float deltaTime,size_t nb)
+	{
+		size_t i = 0;
+#if SPK_SIMD_WIDTH > 1
+		const SPK_SIMD_TYPE dt = SPK_SIMD_SET(deltaTime);
+		for (; i + SPK_SIMD_WIDTH <= nb; i += SPK_SIMD_WIDTH)
+		{
+			SPK_SIMD_TYPE position = SPK_SIMD_LOAD(positions + i);
+			SPK_SIMD_STORE(oldPositions + i,position);
+			SPK_SIMD_STORE(positions + i,SPK_SIMD_ADD(position,SPK_SIMD_MUL(SPK_SIMD_LOAD(velocities + i),dt)));
+		}
+#endif
+		for (; i < nb; ++i)
+		{
+			oldPositions[i] = positions[i];
+			positions[i] += velocities[i] * deltaTime;
+		}
+	}
+
+	void kernelLerp(float* result,const float* from,const float* to,float ratio,size_t nb)
+	{
+		size_t i = 0;
+#if SPK_SIMD_WIDTH > 1
+		const SPK_SIMD_TYPE r = SPK_SIMD_SET(ratio);
+		for (; i + SPK_SIMD_WIDTH <= nb; i += SPK_SIMD_WIDTH)
+		{
+			SPK_SIMD_TYPE f = SPK_SIMD_LOAD(from + i);
+			SPK_SIMD_STORE(result + i,SPK_SIMD_ADD(f,SPK_SIMD_MUL(SPK_SIMD_SUB(SPK_SIMD_LOAD(to + i),f),r)));
+		}
+#endif
+		for (; i < nb; ++i)
+			result[i] = from[i] + (to[i] - from[i]) * ratio;
+	}
+
+	void kernelSqrDistances(float* sqrDists,const float* x,const float* y,const float* z,float px,float py,float pz,size_t nb)
+	{
+		size_t i = 0;
+#if SPK_SIMD_WIDTH > 1
+		const SPK_SIMD_TYPE vx = SPK_SIMD_SET(px);
+		const SPK_SIMD_TYPE vy = SPK_SIMD_SET(py);
+		const SPK_SIMD_TYPE vz = SPK_SIMD_SET(pz);
+		for (; i + SPK_SIMD_WIDTH <= nb; i += SPK_SIMD_WIDTH)
+		{
+			SPK_SIMD_TYPE dx = SPK_SIMD_SUB(SPK_SIMD_LOAD(x + i),vx);
+			SPK_SIMD_TYPE dy = SPK_SIMD_SUB(SPK_SIMD_LOAD(y + i),vy);
+			SPK_SIMD_TYPE dz = SPK_SIMD_SUB(SPK_SIMD_LOAD(z + i),vz);
+			SPK_SIMD_STORE(sqrDists + i,SPK_SIMD_ADD(SPK_SIMD_ADD(SPK_SIMD_MUL(dx,dx),SPK_SIMD_MUL(dy,dy)),SPK_SIMD_MUL(dz,dz)));
+		}
+#endif
+		for (; i < nb; ++i)
+		{
+			const float dx = x[i] - px;
+			const float dy = y[i] - py;
+			const float dz = z[i] - pz;
+			sqrDists[i] = dx * dx + dy * dy + dz * dz;
+		}
+	}
+
+	const char* getKernelInstructionSet()
+	{
+#if defined(SPK_SIMD_AVX)
+		return "AVX";
+#elif defined(SPK_SIMD_SSE)
+		return "SSE";
+#elif defined(SPK_SIMD_NEON)
+		return "NEON";
+#else
+		return "Scalar";
+#endif
+	}
+}
@@ -21,6 +21,16 @@
 
 #include <fstream>
 #include <ctime>
+#include <cstring>
+#include <cstdio>
+
+#ifndef SPK_NO_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#endif
 
 #include <SPARK_Core.h>
 
@@ -37,6 +47,136 @@ namespace SPK
 		"FATAL ERROR",
 	};
 
+#ifndef SPK_NO_THREADS
+
+	// A bounded multiple producers single consumer queue of entries
+	// Each slot holds a sequence number telling whether it can be written by a producer or read by the background thread
+	struct Logger::AsyncBackend
+	{
+		static const size_t NB_SLOTS = 1024; // Must be a power of 2
+		static const int WRITE_PERIOD = 10; // Period in ms at which the background thread writes the entries
+
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			LogPriority priority;
+			time_t time;
+			size_t length;
+			char entry[MAX_ASYNC_ENTRY_LENGTH];
+		};
+
+		Slot slots[NB_SLOTS];
+		std::atomic<size_t> writeIndex;
+		std::atomic<size_t> readIndex;
+		std::atomic<size_t> nbDroppedEntries;
+
+		std::thread worker;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool stop; // Protected by the mutex
+
+		AsyncBackend() :
+			writeIndex(0),
+			readIndex(0),
+			nbDroppedEntries(0),
+			stop(false)
+		{
+			for (size_t i = 0; i < NB_SLOTS; ++i)
+				slots[i].sequence.store(i,std::memory_order_relaxed);
+		}
+
+		void push(LogPriority priority,time_t time,const std::string& entry)
+		{
+			size_t index = writeIndex.load(std::memory_order_relaxed);
+			Slot* slot;
+			while (true)
+			{
+				slot = &slots[index & (NB_SLOTS - 1)];
+				const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				if (sequence == index)
+				{
+					if (writeIndex.compare_exchange_weak(index,index + 1,std::memory_order_relaxed))
+						break;
+				}
+				else if (sequence < index) // The queue is full, the entry is dropped rather than waiting
+				{
+					nbDroppedEntries.fetch_add(1,std::memory_order_relaxed);
+					return;
+				}
+				else
+					index = writeIndex.load(std::memory_order_relaxed);
+			}
+
+			slot->priority = priority;
+			slot->time = time;
+			slot->length = entry.size();
+			if (slot->length > MAX_ASYNC_ENTRY_LENGTH)
+				slot->length = MAX_ASYNC_ENTRY_LENGTH;
+			std::memcpy(slot->entry,entry.data(),slot->length);
+			slot->sequence.store(index + 1,std::memory_order_release);
+		}
+
+		void writeEntries(Logger& logger)
+		{
+			size_t index = readIndex.load(std::memory_order_relaxed);
+			bool written = false;
+			while (true)
+			{
+				Slot& slot = slots[index & (NB_SLOTS - 1)];
+				if (slot.sequence.load(std::memory_order_acquire) != index + 1)
+					break;
+
+				logger.writeEntry(slot.priority,slot.time,slot.entry,slot.length);
+				slot.sequence.store(index + NB_SLOTS,std::memory_order_release);
+				readIndex.store(++index,std::memory_order_release);
+				written = true;
+			}
+
+			size_t nbDropped = nbDroppedEntries.exchange(0,std::memory_order_relaxed);
+			if (nbDropped > 0)
+			{
+				std::ostringstream entry;
+				entry << nbDropped << " log entries were dropped as the asynchronous logger was full";
+				const std::string str = entry.str();
+				logger.writeEntry(LOG_PRIORITY_WARNING,std::time(NULL),str.data(),str.size());
+				written = true;
+			}
+
+			if (written)
+				logger.innerStream->flush();
+		}
+
+		void run(Logger& logger)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (!stop)
+			{
+				lock.unlock();
+				writeEntries(logger);
+				lock.lock();
+				if (!stop)
+					condition.wait_for(lock,std::chrono::milliseconds(static_cast<int>(WRITE_PERIOD)));
+			}
+
+			lock.unlock();
+			writeEntries(logger); // Writes the entries left
+		}
+
+		void waitForEntries()
+		{
+			const size_t index = writeIndex.load(std::memory_order_acquire);
+			condition.notify_one();
+			while (readIndex.load(std::memory_order_acquire) < index)
+				std::this_thread::yield();
+		}
+	};
+
+#else
+
+	struct Logger::AsyncBackend {};
+
+#endif
+
 	Logger::Logger() :
 		enabled(true),
 #ifdef _DEBUG
@@ -45,36 +185,126 @@ namespace SPK
 		priorityLevel(LOG_PRIORITY_INFO), // default priority level is INFO in release
 #endif
 		innerStream(&std::cout),
-		prefixFlag(LOG_PREFIX_TIME | LOG_PREFIX_LIB | LOG_PREFIX_PRIORITY)
+		prefixFlag(LOG_PREFIX_TIME | LOG_PREFIX_LIB | LOG_PREFIX_PRIORITY),
+		asyncBackend(NULL)
 	{}
 
+	Logger::~Logger()
+	{
+		setAsynchronous(false);
+	}
+
 	Logger& Logger::get()
 	{
 		static Logger instance;
 		return instance;
 	}
 
+	void Logger::setAsynchronous(bool async)
+	{
+#ifndef SPK_NO_THREADS
+		if (async && asyncBackend == NULL)
+		{
+			asyncBackend = new AsyncBackend(); // Not traced as the logger can outlive the memory tracer
+			asyncBackend->worker = std::thread(&AsyncBackend::run,asyncBackend,std::ref(*this));
+		}
+		else if (!async && asyncBackend != NULL)
+		{
+			{
+				std::lock_guard<std::mutex> lock(asyncBackend->mutex);
+				asyncBackend->stop = true;
+			}
+			asyncBackend->condition.notify_one();
+			asyncBackend->worker.join();
+
+			delete asyncBackend;
+			asyncBackend = NULL;
+		}
+#endif
+	}
+
 	Logger::Stream Logger::getStream(LogPriority priority,bool skipPrefix)
 	{
-		if (!skipPrefix && isEnabled() && priority >= getPriorityLevel())
+		if (!skipPrefix && isLogged(priority))
 			writePrefix(priority);
 
 		return Stream(*innerStream,priority);
 	}
 
+	void Logger::addEntry(LogPriority priority,const std::string& entry)
+	{
+		if (!isLogged(priority))
+			return;
+
+#ifndef SPK_NO_THREADS
+		if (asyncBackend != NULL)
+		{
+			asyncBackend->push(priority,std::time(NULL),entry);
+			return;
+		}
+#endif
+
+		writeEntry(priority,std::time(NULL),entry.data(),entry.size());
+		innerStream->flush();
+	}
+
+	void Logger::flush()
+	{
+		if (!isEnabled())
+			return;
+
+#ifndef SPK_NO_THREADS
+		if (asyncBackend != NULL)
+		{
+			asyncBackend->waitForEntries();
+			return;
+		}
+#endif
+
+		innerStream->flush();
+	}
+
+	void Logger::writeEntry(LogPriority priority,time_t time,const char* entry,size_t length)
+	{
+		writePrefix(priority,time);
+		innerStream->write(entry,length);
+		*innerStream << "\n";
+	}
+
 	void Logger::writePrefix(LogPriority priority)
+	{
+		writePrefix(priority,std::time(NULL));
+	}
+
+	void Logger::writePrefix(LogPriority priority,time_t time)
 	{
 		// Writes date and time
+		// The prefix is cached per thread as synchronous entries can be written by several threads at once
+		// and only formatted again when the second changes
+		static SPK_THREAD_LOCAL time_t prefixTime = 0;
+		static SPK_THREAD_LOCAL char timePrefix[MAX_TIME_PREFIX_LENGTH] = "";
+
 		if (prefixFlag & LOG_PREFIX_TIME)
 		{
-			time_t currentTime = std::time(NULL);
-			tm* timeInfo = localtime(&currentTime);
-			*innerStream << timeInfo->tm_year + 1900 << "/" 
-				<< timeInfo->tm_mon + 1 << "/"
-				<< timeInfo->tm_mday << " "
-				<< timeInfo->tm_hour << ":"
-				<< timeInfo->tm_min << ":"
-				<< timeInfo->tm_sec << " - ";
+			if (time != prefixTime || timePrefix[0] == '\0')
+			{
+				tm timeInfo; // localtime is not reentrant
+#if defined(WIN32) || defined(_WIN32)
+				localtime_s(&timeInfo,&time);
+#else
+				localtime_r(&time,&timeInfo);
+#endif
+				std::sprintf(timePrefix,"%d/%d/%d %d:%d:%d - ",
+					timeInfo.tm_year + 1900,
+					timeInfo.tm_mon + 1,
+					timeInfo.tm_mday,
+					timeInfo.tm_hour,
+					timeInfo.tm_min,
+					timeInfo.tm_sec);
+				prefixTime = time;
+			}
+
+			*innerStream << timePrefix;
 		}
 
 		// Writes the name of the library (SPARK)
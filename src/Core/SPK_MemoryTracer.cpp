@@ -139,3 +139,66 @@ namespace SPK
 }
 
 #endif
+
+#ifdef SPK_MEMORY_STATISTICS
+
+namespace SPK
+{
+	MemoryStatistics::MemoryStatistics()
+	{
+		for (size_t i = 0; i <= MEMORY_ALL; ++i)
+		{
+			sizes[i] = 0;
+			peakSizes[i] = 0;
+		}
+	}
+
+	MemoryStatistics& MemoryStatistics::get()
+	{
+		static MemoryStatistics instance;
+		return instance;
+	}
+
+	void MemoryStatistics::allocate(MemoryCategory category,size_t size)
+	{
+		add(category,size);
+		add(MEMORY_ALL,size);
+	}
+
+	void MemoryStatistics::deallocate(MemoryCategory category,size_t size)
+	{
+		sizes[category] -= size;
+		sizes[MEMORY_ALL] -= size;
+	}
+
+	size_t MemoryStatistics::getSize(MemoryCategory category) const
+	{
+		return sizes[category];
+	}
+
+	size_t MemoryStatistics::getPeakSize(MemoryCategory category) const
+	{
+		return peakSizes[category];
+	}
+
+	void MemoryStatistics::resetPeakSizes()
+	{
+		for (size_t i = 0; i <= MEMORY_ALL; ++i)
+			peakSizes[i] = static_cast<size_t>(sizes[i]);
+	}
+
+	void MemoryStatistics::add(size_t index,size_t size)
+	{
+#ifdef SPK_NO_THREADS
+		sizes[index] += size;
+		if (sizes[index] > peakSizes[index])
+			peakSizes[index] = sizes[index];
+#else
+		const size_t newSize = sizes[index].fetch_add(size,std::memory_order_relaxed) + size;
+		size_t peakSize = peakSizes[index].load(std::memory_order_relaxed);
+		while (newSize > peakSize && !peakSizes[index].compare_exchange_weak(peakSize,newSize,std::memory_order_relaxed));
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,39 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+	void Modifier::initChunk(Group& group,DataSet* dataSet,size_t start,size_t end) const
+	{
+		for (size_t i = start; i < end; ++i)
+		{
+			Particle particle = group.getParticle(i);
+			init(particle,dataSet);
+		}
+	}
+
+	void Modifier::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
+	{
+		SPK_ASSERT(false,"Modifier::modifyChunk(Group&,DataSet*,float,size_t,size_t) const - A chunk safe modifier must override modifyChunk. The particles are not modified");
+	}
+}
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+	NeighborQuery::NeighborQuery(Group& group) :
+		group(group),
+		spatialIndex(group.getSpatialIndex())
+	{
+		SPK_ASSERT(spatialIndex != NULL,"NeighborQuery::NeighborQuery(Group&) - The group has no spatial index");
+	}
+
+	void NeighborQuery::findNeighbors(const Vector3D& position,float radius,size_t excludedIndex,Neighbors& neighbors) const
+	{
+		neighbors.indices.clear();
+		neighbors.x.clear();
+		neighbors.y.clear();
+		neighbors.z.clear();
+
+		spatialIndex->getNeighborBuckets(position,radius,neighbors.buckets);
+		for (size_t i = 0; i < neighbors.buckets.size(); ++i)
+		{
+			size_t nbParticlesInBucket = 0;
+			const unsigned int* bucketParticles = spatialIndex->getParticles(neighbors.buckets[i],nbParticlesInBucket);
+
+			for (size_t j = 0; j < nbParticlesInBucket; ++j)
+				if (bucketParticles[j] != excludedIndex)
+				{
+					const Vector3D& neighborPosition = group.getParticle(bucketParticles[j]).position();
+					neighbors.indices.push_back(bucketParticles[j]);
+					neighbors.x.push_back(neighborPosition.x);
+					neighbors.y.push_back(neighborPosition.y);
+					neighbors.z.push_back(neighborPosition.z);
+				}
+		}
+
+		const size_t nbCandidates = neighbors.indices.size();
+		neighbors.sqrDists.resize(nbCandidates);
+		if (nbCandidates == 0)
+			return;
+
+		kernelSqrDistances(&neighbors.sqrDists[0],&neighbors.x[0],&neighbors.y[0],&neighbors.z[0],position.x,position.y,position.z,nbCandidates);
+
+		// Only the candidates within the radius are kept, in the same order
+		const float sqrRadius = radius * radius;
+		size_t nbNeighbors = 0;
+		for (size_t i = 0; i < nbCandidates; ++i)
+			if (neighbors.sqrDists[i] < sqrRadius)
+			{
+				neighbors.indices[nbNeighbors] = neighbors.indices[i];
+				neighbors.x[nbNeighbors] = neighbors.x[i];
+				neighbors.y[nbNeighbors] = neighbors.y[i];
+				neighbors.z[nbNeighbors] = neighbors.z[i];
+				neighbors.sqrDists[nbNeighbors] = neighbors.sqrDists[i];
+				++nbNeighbors;
+			}
+
+		neighbors.indices.resize(nbNeighbors);
+		neighbors.x.resize(nbNeighbors);
+		neighbors.y.resize(nbNeighbors);
+		neighbors.z.resize(nbNeighbors);
+		neighbors.sqrDists.resize(nbNeighbors);
+	}
+}
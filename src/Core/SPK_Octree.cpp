@@ -49,6 +49,19 @@ namespace SPK
 		SPK_DELETE_ARRAY(maxPos);
 	}
 
+	size_t Octree::getMemorySize() const
+	{
+		size_t size = cells.capacity() * sizeof(Cell) + activeCells.capacity() * sizeof(size_t);
+		for (size_t i = 0; i < cells.capacity(); ++i)
+			size += cells[i].particles.capacity() * sizeof(size_t);
+
+		size += nbParticles * (sizeof(Array<size_t>) + 2 * sizeof(Triplet));
+		for (size_t i = 0; i < nbParticles; ++i)
+			size += particleCells[i].capacity() * sizeof(size_t);
+
+		return size;
+	}
+
 	void Octree::update()
 	{
 		// Reallocates if necessary
@@ -35,4 +35,10 @@ namespace SPK
 	{
 		SPK_LOG_INFO("VBO hint is not yet considered");
 	}
+
+	void Renderer::initChunk(const Group& group,DataSet* dataSet,size_t start,size_t end) const
+	{
+		for (size_t i = start; i < end; ++i)
+			init(group.getParticle(i),dataSet);
+	}
 }
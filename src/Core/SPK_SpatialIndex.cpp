@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+	const float SpatialIndex::MIN_CELL_SIZE = 0.001f;
+
+	class SpatialIndex::BucketTask : public Task
+	{
+	public :
+
+		BucketTask(SpatialIndex& spatialIndex) :
+			spatialIndex(spatialIndex)
+		{}
+
+		virtual void execute(size_t jobIndex)
+		{
+			spatialIndex.computeBuckets(jobIndex);
+		}
+
+	private :
+
+		SpatialIndex& spatialIndex;
+	};
+
+	SpatialIndex::SpatialIndex(Group& group) :
+		group(group),
+		cellSize(0.0f),
+		cellSizeFactor(1.0f),
+		incrementalUpdateEnabled(true),
+		currentCellSize(0.0f),
+		invCellSize(0.0f),
+		maxRadius(0.0f),
+		nbBuckets(0),
+		nbParticles(0),
+		reused(false)
+	{}
+
+	void SpatialIndex::copyParameters(const SpatialIndex& spatialIndex)
+	{
+		cellSize = spatialIndex.cellSize;
+		cellSizeFactor = spatialIndex.cellSizeFactor;
+		incrementalUpdateEnabled = spatialIndex.incrementalUpdateEnabled;
+	}
+
+	size_t SpatialIndex::getMemorySize() const
+	{
+		return (particleBuckets.capacity() + bucketStarts.capacity() + sortedParticles.capacity()) * sizeof(unsigned int) + changedJobs.capacity();
+	}
+
+	void SpatialIndex::update(TaskManager* taskManager)
+	{
+		const size_t nb = group.getNbParticles();
+
+		// The largest radius gives the size of the cells
+		float maxScale = Group::DEFAULT_VALUES[PARAM_SCALE];
+		if (group.isEnabled(PARAM_SCALE) && nb > 0)
+		{
+			const float* scales = group.particleData.parameters[PARAM_SCALE];
+			maxScale = *std::max_element(scales,scales + nb);
+		}
+		maxRadius = maxScale * group.getPhysicalRadius();
+
+		float newCellSize = cellSize;
+		if (newCellSize <= 0.0f)
+			newCellSize = 2.0f * maxRadius * cellSizeFactor;
+		if (newCellSize < MIN_CELL_SIZE)
+			newCellSize = MIN_CELL_SIZE;
+
+		size_t newNbBuckets = MIN_NB_BUCKETS;
+		while (newNbBuckets < nb * 2)
+			newNbBuckets <<= 1;
+
+		// The buckets of the previous update can only be compared if the grid did not change
+		bool incremental = incrementalUpdateEnabled && nb == nbParticles && newCellSize == currentCellSize && newNbBuckets == nbBuckets;
+
+		currentCellSize = newCellSize;
+		invCellSize = 1.0f / newCellSize;
+		nbBuckets = newNbBuckets;
+		nbParticles = nb;
+
+		particleBuckets.resize(nb);
+		const size_t nbJobs = (nb + BUCKET_JOB_SIZE - 1) / BUCKET_JOB_SIZE;
+		changedJobs.assign(nbJobs,incremental ? 0 : 1);
+
+		BucketTask task(*this);
+		if (taskManager != NULL && nbJobs > 1)
+			taskManager->execute(task,nbJobs);
+		else
+			for (size_t i = 0; i < nbJobs; ++i)
+				task.execute(i);
+
+		reused = incremental && std::find(changedJobs.begin(),changedJobs.end(),1) == changedJobs.end();
+		if (!reused)
+			sortParticles();
+	}
+
+	void SpatialIndex::computeBuckets(size_t job)
+	{
+		const size_t start = job * BUCKET_JOB_SIZE;
+		const size_t end = std::min(start + BUCKET_JOB_SIZE,nbParticles);
+		const Vector3D* positions = group.particleData.positions;
+
+		unsigned int changed = 0;
+		for (size_t i = start; i < end; ++i)
+		{
+			const unsigned int bucket = static_cast<unsigned int>(getBucket(positions[i]));
+			changed |= bucket ^ particleBuckets[i];
+			particleBuckets[i] = bucket;
+		}
+
+		if (changed != 0)
+			changedJobs[job] = 1;
+	}
+
+	void SpatialIndex::sortParticles()
+	{
+		// Counting sort of the particles by bucket
+		bucketStarts.assign(nbBuckets + 1,0);
+		for (size_t i = 0; i < nbParticles; ++i)
+			++bucketStarts[particleBuckets[i] + 1];
+
+		// The ends of the buckets are computed first and particles are put from the end, the ends are then the starts
+		for (size_t i = 1; i <= nbBuckets; ++i)
+			bucketStarts[i] += bucketStarts[i - 1];
+		for (size_t i = 0; i < nbBuckets; ++i)
+			bucketStarts[i] = bucketStarts[i + 1];
+
+		sortedParticles.resize(std::max<size_t>(nbParticles,1));
+		for (size_t i = nbParticles; i > 0; --i)
+			sortedParticles[--bucketStarts[particleBuckets[i - 1]]] = static_cast<unsigned int>(i - 1);
+	}
+
+	void SpatialIndex::getNeighborBuckets(const Vector3D& position,float distance,std::vector<size_t>& buckets) const
+	{
+		buckets.clear();
+
+		const int minX = getCellCoordinate(position.x - distance);
+		const int minY = getCellCoordinate(position.y - distance);
+		const int minZ = getCellCoordinate(position.z - distance);
+		const int maxX = getCellCoordinate(position.x + distance);
+		const int maxY = getCellCoordinate(position.y + distance);
+		const int maxZ = getCellCoordinate(position.z + distance);
+
+		// When the distance spans more cells than there are buckets, all buckets are returned
+		const double nbCells = (maxX - minX + 1.0) * (maxY - minY + 1.0) * (maxZ - minZ + 1.0);
+		if (nbCells >= nbBuckets)
+		{
+			for (size_t i = 0; i < nbBuckets; ++i)
+				buckets.push_back(i);
+			return;
+		}
+
+		for (int x = minX; x <= maxX; ++x)
+			for (int y = minY; y <= maxY; ++y)
+				for (int z = minZ; z <= maxZ; ++z)
+					buckets.push_back(hashCell(x,y,z));
+
+		// Several cells can share a bucket
+		std::sort(buckets.begin(),buckets.end());
+		buckets.erase(std::unique(buckets.begin(),buckets.end()),buckets.end());
+	}
+}
@@ -34,26 +34,69 @@ namespace SPK
 	bool System::clampStepEnabled(false);
 	float System::clampStep(1.0f);
 
+	unsigned int System::nextLODPhase(0);
+
+#ifdef SPK_PROFILING
+	const float System::PROFILING_AVERAGE_WEIGHT = 0.1f;
+#endif
+
 	System::System(bool initialize) :
 		Transformable(SHARE_POLICY_TRUE),
 		groups(),
+		taskManager(NULL),
+		LODPhase(nextLODPhase++),
+		LODFrame(0),
+		currentLODPeriod(1),
+		LODDeltaTime(0.0f),
+		emissionScale(1.0f),
+		budgetRegistered(false),
+		visible(true),
+		hiddenTime(0.0f),
+		visibilityMargin(0.0f),
+		catchUpStep(0.1f),
+		particleBoundsValid(false),
 		deltaStep(0.0f),
+		renderInterpolationEnabled(false),
+		interpolationRatio(1.0f),
 		AABBComputationEnabled(false),
 		AABBMin(),
 		AABBMax(),
 		initialized(initialize),
 		active(true)
-	{}
+	{
+#ifdef SPK_PROFILING
+		profilingEnabled = false;
+#endif
+	}
 
 	System::System(const System& system) :
 		Transformable(system),
+		taskManager(system.taskManager),
+		LODLevels(system.LODLevels),
+		LODPhase(nextLODPhase++),
+		LODFrame(0),
+		currentLODPeriod(1),
+		LODDeltaTime(0.0f),
+		emissionScale(1.0f),
+		budgetRegistered(false),
+		visible(true),
+		hiddenTime(0.0f),
+		visibilityMargin(system.visibilityMargin),
+		catchUpStep(system.catchUpStep),
+		particleBoundsValid(false),
 		deltaStep(0.0f),
+		renderInterpolationEnabled(system.renderInterpolationEnabled),
+		interpolationRatio(1.0f),
 		AABBComputationEnabled(system.AABBComputationEnabled),
 		AABBMin(system.AABBMin),
 		AABBMax(system.AABBMax),
 		initialized(system.initialized),
 		active(system.active)
 	{
+#ifdef SPK_PROFILING
+		profilingEnabled = system.profilingEnabled;
+#endif
+
 		for (std::vector<Ref<Group> >::const_iterator it = system.groups.begin(); it != system.groups.end(); ++it)
 		{
 			Ref<Group> group = system.copyChild(*it);
@@ -64,6 +107,9 @@ namespace SPK
 
 	System::~System()
 	{
+		if (budgetRegistered)
+			BudgetManager::get().removeSystem(this);
+
 		while (groups.size() > 0)
 			removeGroup(groups.back());
 	}
@@ -142,6 +188,12 @@ namespace SPK
 		return nbParticles;
 	}
 
+	void System::setRandomSeed(unsigned int seed)
+	{
+		for (size_t i = 0; i < groups.size(); ++i)
+			groups[i]->setRandomSeed(seed + static_cast<unsigned int>(i) * 0x9E3779B9u);
+	}
+
 	bool System::updateParticles(float deltaTime)
 	{
 		if (!initialized)
@@ -150,11 +202,53 @@ namespace SPK
 			return true;
 		}
 
+#ifdef SPK_PROFILING
+		if (profilingEnabled)
+		{
+			for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+				(*it)->beginStatsFrame(true);
+
+			bool alive = updateFrame(deltaTime);
+			endStatsFrame();
+			return alive;
+		}
+#endif
+
+		return updateFrame(deltaTime);
+	}
+
+	bool System::updateFrame(float deltaTime)
+	{
 		bool alive = true;
 
 		if (clampStepEnabled && deltaTime > clampStep)
 			deltaTime = clampStep;
 
+		// Hidden systems only accumulate the time and catch up when visible again
+		if (!visible)
+		{
+			hiddenTime += deltaTime;
+			return active;
+		}
+
+		if (hiddenTime > 0.0f)
+		{
+			fastForward(hiddenTime,catchUpStep,MAX_CATCH_UP_STEPS);
+			hiddenTime = 0.0f;
+		}
+
+		// Distant systems are only updated every n calls with the accumulated time
+		if (!LODLevels.empty())
+		{
+			currentLODPeriod = computeLODPeriod();
+			LODDeltaTime += deltaTime;
+			if ((++LODFrame + LODPhase) % currentLODPeriod != 0)
+				return active;
+
+			deltaTime = LODDeltaTime;
+			LODDeltaTime = 0.0f;
+		}
+
 		if (stepMode != STEP_MODE_REAL)
 		{
 			deltaTime += deltaStep;
@@ -179,12 +273,83 @@ namespace SPK
 				deltaTime -= updateStep;
 			}
 			deltaStep = deltaTime;
+
+			// Renders between the previous and the current step
+			if (renderInterpolationEnabled && updateStep > 0.0f)
+				interpolationRatio = std::min(deltaStep / updateStep,1.0f);
 		}
 		else
+		{
 			alive = innerUpdate(deltaTime);
+			interpolationRatio = 1.0f;
+		}
+
+		updateDisplay();
+
+		active = alive;
+		return active;
+	}
+
+	void System::prewarm(float time,float step)
+	{
+		if (!initialized)
+		{
+			SPK_LOG_WARNING("System::prewarm(float,float) - An uninitialized system cannot be prewarmed");
+			return;
+		}
+
+		if (step <= 0.0f)
+		{
+			SPK_LOG_WARNING("System::prewarm(float,float) - The step must be positive - 0.1 is used");
+			step = 0.1f;
+		}
+
+		if (time <= 0.0f)
+			return;
+
+		fastForward(time,step,std::numeric_limits<size_t>::max());
 
 		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+			(*it)->prepareDisplay();
+		updateDisplay();
+	}
+
+	void System::reset()
+	{
+		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+		{
+			(*it)->empty();
+			(*it)->emptyBufferedParticles();
+
+			for (size_t i = 0; i < (*it)->getNbEmitters(); ++i)
+				(*it)->getEmitter(i)->resetTank();
+		}
+
+		deltaStep = 0.0f;
+		interpolationRatio = 1.0f;
+		LODFrame = 0;
+		LODDeltaTime = 0.0f;
+		visible = true;
+		hiddenTime = 0.0f;
+		particleBoundsValid = false;
+		active = true;
+
+		AABBMin = AABBMax = getTransform().getWorldPos();
+	}
+
+	void System::updateDisplay()
+	{
+		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+		{
+#ifdef SPK_PROFILING
+			StatsTimer timer;
+#endif
 			(*it)->sortParticles();
+#ifdef SPK_PROFILING
+			if ((*it)->profilingEnabled)
+				(*it)->stats.frame.stageTimes[PROFILE_STAGE_SORTING] += timer.getElapsedTime();
+#endif
+		}
 
 		if (isAABBComputationEnabled())
 		{
@@ -194,7 +359,14 @@ namespace SPK
 
 			for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
 			{
+#ifdef SPK_PROFILING
+				StatsTimer timer;
+#endif
 				(*it)->computeAABB();
+#ifdef SPK_PROFILING
+				if ((*it)->profilingEnabled)
+					(*it)->stats.frame.stageTimes[PROFILE_STAGE_AABB] += timer.getElapsedTime();
+#endif
 
 				AABBMin.setMin((*it)->getAABBMin());
 				AABBMax.setMax((*it)->getAABBMax());
@@ -205,9 +377,77 @@ namespace SPK
 			const Vector3D pos = getTransform().getWorldPos();
 			AABBMin = AABBMax = pos;
 		}
+	}
 
-		active = alive;
-		return active;
+#ifdef SPK_PROFILING
+	void System::resetStats()
+	{
+		stats.reset();
+		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+			(*it)->stats.reset();
+	}
+
+	void System::endStatsFrame()
+	{
+		StatsCounters frame;
+		std::vector<HandlerStats> handlers;
+
+		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+		{
+			(*it)->endStatsFrame(PROFILING_AVERAGE_WEIGHT);
+			const Stats& groupStats = (*it)->stats;
+			frame.add(groupStats.frame);
+
+			// A handler shared by several groups gets the sum of its times
+			for (std::vector<HandlerStats>::const_iterator handlerIt = groupStats.handlers.begin(); handlerIt != groupStats.handlers.end(); ++handlerIt)
+			{
+				std::vector<HandlerStats>::iterator systemHandlerIt = handlers.begin();
+				while (systemHandlerIt != handlers.end() && systemHandlerIt->handler != handlerIt->handler)
+					++systemHandlerIt;
+
+				if (systemHandlerIt == handlers.end())
+					handlers.push_back(*handlerIt);
+				else
+				{
+					systemHandlerIt->time += handlerIt->time;
+					systemHandlerIt->averageTime += handlerIt->averageTime;
+				}
+			}
+		}
+
+		stats.frame = frame;
+		if (stats.nbFrames == 0)
+			stats.average = frame;
+		else
+			stats.average.blend(frame,PROFILING_AVERAGE_WEIGHT);
+		stats.handlers.swap(handlers);
+		++stats.nbFrames;
+	}
+#endif
+
+	void System::addLODLevel(float distance,unsigned int updatePeriod)
+	{
+		if (updatePeriod == 0)
+		{
+			SPK_LOG_WARNING("System::addLODLevel(float,unsigned int) - The update period must be at least 1 - 1 is used");
+			updatePeriod = 1;
+		}
+
+		LODLevel level;
+		level.sqrDistance = distance * distance;
+		level.updatePeriod = updatePeriod;
+		LODLevels.insert(std::upper_bound(LODLevels.begin(),LODLevels.end(),level),level);
+	}
+
+	unsigned int System::computeLODPeriod() const
+	{
+		Vector3D center = isAABBComputationEnabled() ? (AABBMin + AABBMax) * 0.5f : getTransform().getWorldPos();
+		float sqrDist = getSqrDist(center,cameraPosition);
+
+		unsigned int period = 1;
+		for (std::vector<LODLevel>::const_iterator it = LODLevels.begin(); it != LODLevels.end() && it->sqrDistance <= sqrDist; ++it)
+			period = it->updatePeriod;
+		return period;
 	}
 
 	void System::renderParticles() const
@@ -246,8 +486,121 @@ namespace SPK
 		return SPK_NULL_REF;
 	}
 
-	bool System::innerUpdate(float deltaTime)
+	bool System::updateVisibility(const Frustum& frustum)
 	{
+		// The transform is updated as a hidden system is not updated anymore
+		updateTransform();
+
+		Vector3D conservativeMin,conservativeMax;
+		computeConservativeAABB(conservativeMin,conservativeMax);
+		visible = frustum.intersects(conservativeMin,conservativeMax);
+		return visible;
+	}
+
+	void System::computeConservativeAABB(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		const float maxFloat = std::numeric_limits<float>::max();
+
+		// The bounds of living particles do not change until the next update
+		if (!particleBoundsValid)
+		{
+			particleBoundsMin.set(maxFloat,maxFloat,maxFloat);
+			particleBoundsMax.set(-maxFloat,-maxFloat,-maxFloat);
+			for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+				(*it)->computeParticleBounds(particleBoundsMin,particleBoundsMax);
+			particleBoundsValid = true;
+		}
+
+		AABBMin = particleBoundsMin;
+		AABBMax = particleBoundsMax;
+		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+			(*it)->computeEmissionBounds(AABBMin,AABBMax);
+
+		if (visibilityMargin > 0.0f)
+		{
+			const Vector3D margin(visibilityMargin,visibilityMargin,visibilityMargin);
+			AABBMin -= margin;
+			AABBMax += margin;
+		}
+	}
+
+	void System::setVisibilityMargin(float margin)
+	{
+		if (margin < 0.0f)
+		{
+			SPK_LOG_WARNING("System::setVisibilityMargin(float) - The margin cannot be negative - 0 is used");
+			margin = 0.0f;
+		}
+
+		visibilityMargin = margin;
+	}
+
+	void System::setCatchUpStep(float catchUpStep)
+	{
+		if (catchUpStep <= 0.0f)
+		{
+			SPK_LOG_WARNING("System::setCatchUpStep(float) - The catch up step must be positive - 0.1 is used");
+			catchUpStep = 0.1f;
+		}
+
+		this->catchUpStep = catchUpStep;
+	}
+
+	float System::computeMaxChainedLifeTime() const
+	{
+		const float infinity = std::numeric_limits<float>::infinity();
+		const size_t nbGroups = groups.size();
+
+		// The particles of a group can live for its maximum life time after the death of the last particle of a group feeding it
+		std::vector<float> lifeTimes(nbGroups);
+		for (size_t i = 0; i < nbGroups; ++i)
+			lifeTimes[i] = groups[i]->isImmortal() ? infinity : groups[i]->getMaxLifeTime();
+
+		std::vector<float> chainedLifeTimes(lifeTimes);
+		for (size_t pass = 0; pass <= nbGroups; ++pass)
+		{
+			bool changed = false;
+			for (size_t i = 0; i < nbGroups; ++i)
+				for (size_t j = 0; j < nbGroups; ++j)
+					if (groups[j]->feeds(*groups[i]) && lifeTimes[i] + chainedLifeTimes[j] > chainedLifeTimes[i])
+					{
+						chainedLifeTimes[i] = lifeTimes[i] + chainedLifeTimes[j];
+						changed = true;
+					}
+
+			if (!changed)
+				return nbGroups > 0 ? *std::max_element(chainedLifeTimes.begin(),chainedLifeTimes.end()) : 0.0f;
+		}
+
+		// Groups feeding each other can live forever
+		return infinity;
+	}
+
+	void System::fastForward(float time,float step,size_t maxNbSteps)
+	{
+		// Particles born before the last maximum life time of the chains of groups are dead, only the tanks of emitters are updated for that time
+		const float maxLifeTime = computeMaxChainedLifeTime();
+		if (time > maxLifeTime)
+		{
+			for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
+				(*it)->skipTime(time - maxLifeTime);
+			time = maxLifeTime;
+		}
+
+		// The simulated time is bounded so that steps are never longer than the given step, the time beyond is dropped
+		if (time > maxNbSteps * step)
+			time = maxNbSteps * step;
+
+		// The remaining time is simulated with large steps, without what is only needed for display
+		const size_t nbSteps = static_cast<size_t>(std::ceil(time / step));
+		for (size_t i = 0; i < nbSteps; ++i)
+			innerUpdate(time / nbSteps,false);
+	}
+
+	bool System::innerUpdate(float deltaTime,bool display)
+	{
+		particleBoundsValid = false;
+
 		// Transform
 		updateTransform();
 
@@ -261,7 +614,7 @@ namespace SPK
 		// Particles
 		bool alive = false;
 		for (std::vector<Ref<Group> >::const_iterator it = groups.begin(); it != groups.end(); ++it)
-			alive |= (*it)->updateParticles(deltaTime);
+			alive |= (*it)->updateParticles(deltaTime,display);
 		return alive;
 	}
 
@@ -281,8 +634,16 @@ namespace SPK
 			if (remove && group->system != NULL)
 				group->system->removeGroup(group);
 
+#ifdef SPK_MEMORY_STATISTICS
+			group->releaseMemoryStatistics(); // The memory of the group moves to the statistics of the new system
+#endif
+
 			group->system = system;
 			group->initData(); // To initialize the group if needed
+
+#ifdef SPK_MEMORY_STATISTICS
+			group->updateMemoryStatistics();
+#endif
 		}
 	}
 }
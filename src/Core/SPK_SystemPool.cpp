@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+	SystemPool::SystemPool(const Ref<System>& prototype,size_t nbInstances) :
+		prototype(prototype),
+		freeInstances(),
+		usedInstances(),
+		nbCreatedInstances(0)
+	{
+		SPK_ASSERT(prototype,"SystemPool::SystemPool(const Ref<System>&,size_t) - The prototype must not be NULL");
+
+		shareConfiguration(prototype);
+		reserve(nbInstances);
+	}
+
+	Ref<System> SystemPool::acquire()
+	{
+		Ref<System> instance;
+		if (freeInstances.empty())
+			instance = createInstance();
+		else
+		{
+			instance = freeInstances.back();
+			freeInstances.pop_back();
+		}
+
+		usedInstances.insert(instance.get());
+		return instance;
+	}
+
+	void SystemPool::release(const Ref<System>& system)
+	{
+		if (!system)
+		{
+			SPK_LOG_WARNING("SystemPool::release(const Ref<System>&) - The system to release is NULL");
+			return;
+		}
+
+		// Releasing twice would make the next acquisitions return the same instance
+		if (usedInstances.erase(system.get()) == 0)
+		{
+			SPK_LOG_WARNING("SystemPool::release(const Ref<System>&) - The system " << system.get() << " was not acquired from this pool or is already released");
+			return;
+		}
+
+		system->reset();
+		freeInstances.push_back(system);
+	}
+
+	void SystemPool::reserve(size_t nbInstances)
+	{
+		freeInstances.reserve(nbInstances);
+		while (freeInstances.size() < nbInstances)
+			freeInstances.push_back(createInstance());
+	}
+
+	Ref<System> SystemPool::createInstance()
+	{
+		++nbCreatedInstances;
+		return SPKObject::copy(prototype);
+	}
+
+	void SystemPool::shareConfiguration(const Ref<System>& system)
+	{
+		for (size_t i = 0; i < system->getNbGroups(); ++i)
+		{
+			const Ref<Group>& group = system->getGroup(i);
+
+			share(group->getColorInterpolator().get());
+			for (int j = PARAM_SCALE; j <= PARAM_ROTATION_SPEED; ++j)
+				share(group->getParamInterpolator(static_cast<Param>(j)).get());
+
+			share(group->getRenderer().get());
+
+			for (size_t j = 0; j < group->getNbModifiers(); ++j)
+			{
+				const Ref<Modifier>& modifier = group->getModifier(j);
+				if (!modifier->isLocalToSystem() && modifier->isShareable())
+					share(modifier.get());
+			}
+		}
+	}
+
+	void SystemPool::share(SPKObject* object)
+	{
+		if (object != NULL && !object->isShared())
+			object->setShared(true);
+	}
+}
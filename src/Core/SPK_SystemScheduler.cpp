@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+	class SystemScheduler::UpdateTask : public Task
+	{
+	public :
+
+		UpdateTask(const std::vector<Ref<System> >& systems,float deltaTime) :
+			systems(systems),
+			deltaTime(deltaTime)
+		{}
+
+		virtual void execute(size_t jobIndex)
+		{
+			systems[jobIndex]->updateParticles(deltaTime);
+		}
+
+	private :
+
+		const std::vector<Ref<System> >& systems;
+		const float deltaTime;
+
+		UpdateTask& operator=(const UpdateTask&); // Not used
+	};
+
+	SystemScheduler::SystemScheduler(TaskManager* taskManager) :
+		systems(),
+		taskManager(taskManager),
+		defaultTaskManager(NULL)
+	{}
+
+	SystemScheduler::~SystemScheduler()
+	{
+		if (defaultTaskManager != NULL)
+			SPK_DELETE(defaultTaskManager);
+	}
+
+	void SystemScheduler::setTaskManager(TaskManager* taskManager)
+	{
+		this->taskManager = taskManager;
+	}
+
+	void SystemScheduler::addSystem(const Ref<System>& system)
+	{
+		if (!system)
+		{
+			SPK_LOG_WARNING("SystemScheduler::addSystem(const Ref<System>&) - The system to add is NULL");
+			return;
+		}
+
+		if (std::find(systems.begin(),systems.end(),system.get()) != systems.end())
+		{
+			SPK_LOG_WARNING("SystemScheduler::addSystem(const Ref<System>&) - The system " << system.get() << " is already in the scheduler");
+			return;
+		}
+
+		systems.push_back(system);
+	}
+
+	void SystemScheduler::removeSystem(const Ref<System>& system)
+	{
+		std::vector<Ref<System> >::iterator it = std::find(systems.begin(),systems.end(),system.get());
+		if (it != systems.end())
+			systems.erase(it);
+		else
+		{
+			SPK_LOG_WARNING("SystemScheduler::removeSystem(const Ref<System>&) - The system " << system.get() << " was not found in the scheduler and cannot be removed");
+		}
+	}
+
+	bool SystemScheduler::updateParticles(const std::vector<Ref<System> >& systems,float deltaTime)
+	{
+		if (systems.empty())
+			return false;
+
+#ifdef SPK_TRACE_MEMORY
+		// The memory tracer is not thread safe
+		for (std::vector<Ref<System> >::const_iterator it = systems.begin(); it != systems.end(); ++it)
+			(*it)->updateParticles(deltaTime);
+#else
+		TaskManager* manager = taskManager;
+		if (manager == NULL)
+		{
+			if (defaultTaskManager == NULL)
+				defaultTaskManager = SPK_NEW(ThreadPool);
+			manager = defaultTaskManager;
+		}
+
+		UpdateTask task(systems,deltaTime);
+		manager->execute(task,systems.size());
+#endif
+
+		bool active = false;
+		for (std::vector<Ref<System> >::const_iterator it = systems.begin(); it != systems.end(); ++it)
+			active |= (*it)->isActive();
+		return active;
+	}
+}
@@ -0,0 +1,186 @@
+//////////////////////////////////////////////////////////////////////////////////
+// SPARK particle engine														//
+// Copyright (C) 2008-2013 - Julien Fryer - julienfryer@gmail.com				//
+//																				//
+// This software is provided 'as-is', without any express or implied			//
+// warranty.  In no event will the authors be held liable for any damages		//
+// arising from the use of this software.										//
+//																				//
+// Permission is granted to anyone to use this software for any purpose,		//
+// including commercial applications, and to alter it and redistribute it		//
+// freely, subject to the following restrictions:								//
+//																				//
+// 1. The origin of this software must not be misrepresented; you must not		//
+//    claim that you wrote the original software. If you use this software		//
+//    in a product, an acknowledgment in the product documentation would be		//
+//    appreciated but is not required.											//
+// 2. Altered source versions must be plainly marked as such, and must not be	//
+//    misrepresented as being the original software.							//
+// 3. This notice may not be removed or altered from any source distribution.	//
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPK_NO_THREADS
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#endif
+
+#include <SPARK_Core.h>
+
+namespace SPK
+{
+#ifndef SPK_NO_THREADS
+
+	struct ThreadPool::Implementation
+	{
+		std::vector<std::thread> workers;
+
+		std::mutex mutex;
+		std::condition_variable startCondition;
+		std::condition_variable endCondition;
+
+		// State of the task being executed (protected by the mutex)
+		Task* task;
+		size_t nbJobs;
+		size_t nbRunningWorkers;
+		unsigned int generation;
+		bool busy;
+		bool stop;
+
+		std::atomic<size_t> nextJob;
+
+		Implementation() :
+			task(NULL),
+			nbJobs(0),
+			nbRunningWorkers(0),
+			generation(0),
+			busy(false),
+			stop(false),
+			nextJob(0)
+		{}
+
+		void executeJobs(Task& task,size_t nbJobs)
+		{
+			size_t jobIndex;
+			while ((jobIndex = nextJob.fetch_add(1)) < nbJobs)
+				task.execute(jobIndex);
+		}
+
+		void workerLoop()
+		{
+			unsigned int lastGeneration = 0;
+			std::unique_lock<std::mutex> lock(mutex);
+
+			while (true)
+			{
+				while (!stop && (task == NULL || generation == lastGeneration))
+					startCondition.wait(lock);
+
+				if (stop)
+					return;
+
+				lastGeneration = generation;
+				Task* currentTask = task;
+				size_t currentNbJobs = nbJobs;
+				++nbRunningWorkers;
+
+				lock.unlock();
+				executeJobs(*currentTask,currentNbJobs);
+				lock.lock();
+
+				if (--nbRunningWorkers == 0)
+					endCondition.notify_all();
+			}
+		}
+	};
+
+	ThreadPool::ThreadPool(size_t nbThreads) :
+		implementation(SPK_NEW(Implementation))
+	{
+		if (nbThreads == 0)
+			nbThreads = std::thread::hardware_concurrency();
+
+		// The calling thread is one of the threads of the pool
+		for (size_t i = 1; i < nbThreads; ++i)
+			implementation->workers.push_back(std::thread(&Implementation::workerLoop,implementation));
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(implementation->mutex);
+			implementation->stop = true;
+		}
+		implementation->startCondition.notify_all();
+
+		for (std::vector<std::thread>::iterator it = implementation->workers.begin(); it != implementation->workers.end(); ++it)
+			it->join();
+
+		SPK_DELETE(implementation);
+	}
+
+	void ThreadPool::execute(Task& task,size_t nbJobs)
+	{
+		if (nbJobs == 0)
+			return;
+
+		std::unique_lock<std::mutex> lock(implementation->mutex);
+
+		// Nested or concurrent calls and single jobs are executed on the calling thread
+		if (implementation->busy || implementation->workers.empty() || nbJobs == 1)
+		{
+			lock.unlock();
+			for (size_t i = 0; i < nbJobs; ++i)
+				task.execute(i);
+			return;
+		}
+
+		implementation->busy = true;
+		implementation->task = &task;
+		implementation->nbJobs = nbJobs;
+		implementation->nextJob = 0;
+		++implementation->generation;
+		lock.unlock();
+
+		implementation->startCondition.notify_all();
+		implementation->executeJobs(task,nbJobs);
+
+		// All jobs are taken, waits for the workers still executing some
+		lock.lock();
+		while (implementation->nbRunningWorkers > 0)
+			implementation->endCondition.wait(lock);
+
+		implementation->task = NULL;
+		implementation->busy = false;
+	}
+
+	size_t ThreadPool::getNbThreads() const
+	{
+		return implementation->workers.size() + 1;
+	}
+
+#else
+
+	struct ThreadPool::Implementation {};
+
+	ThreadPool::ThreadPool(size_t nbThreads) :
+		implementation(NULL)
+	{}
+
+	ThreadPool::~ThreadPool() {}
+
+	void ThreadPool::execute(Task& task,size_t nbJobs)
+	{
+		for (size_t i = 0; i < nbJobs; ++i)
+			task.execute(i);
+	}
+
+	size_t ThreadPool::getNbThreads() const
+	{
+		return 1;
+	}
+
+#endif
+}
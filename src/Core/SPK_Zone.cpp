@@ -19,12 +19,21 @@
 // 3. This notice may not be removed or altered from any source distribution.	//
 //////////////////////////////////////////////////////////////////////////////////
 
+#include <limits> // for max float value
+
 #include <SPARK_Core.h>
 
 namespace SPK
 {
 	SPK_DEFINE_ENUM(ZoneTest, SPK_ENUM_ZONE_TEST)
 
+	void Zone::computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		const float MAX_FLOAT = std::numeric_limits<float>::max();
+		AABBMin.set(-MAX_FLOAT,-MAX_FLOAT,-MAX_FLOAT);
+		AABBMax.set(MAX_FLOAT,MAX_FLOAT,MAX_FLOAT);
+	}
+
 	Zone::checkFn Zone::TEST_FN[Zone::NB_TEST_TYPES] =
 	{
 		&Zone::checkInside,
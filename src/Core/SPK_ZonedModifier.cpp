@@ -30,8 +30,9 @@ namespace SPK
 		bool NEEDS_OCTREE,
 		int ZONE_TEST_FLAG,
 		ZoneTest zoneTest,
-		const Ref<Zone>& zone) :
-		Modifier(PRIORITY,NEEDS_DATASET,CALL_INIT,NEEDS_OCTREE),
+		const Ref<Zone>& zone,
+		bool CHUNK_SAFE) :
+		Modifier(PRIORITY,NEEDS_DATASET,CALL_INIT,NEEDS_OCTREE,CHUNK_SAFE),
 		ZONE_TEST_FLAG(ZONE_TEST_FLAG),
 		zoneTest(zoneTest),
 		zone()
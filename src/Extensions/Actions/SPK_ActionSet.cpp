@@ -71,6 +71,14 @@ namespace SPK
 			(*it)->apply(particle);
 	}
 
+	bool ActionSet::spawnsInto(const Group& group) const
+	{
+		for (std::vector<Ref<Action> >::const_iterator it = actions.begin(); it != actions.end(); ++it)
+			if ((*it)->spawnsInto(group))
+				return true;
+		return false;
+	}
+
 	Ref<SPKObject> ActionSet::findByName(const std::string& name)
 	{
 		Ref<SPKObject> object = Action::findByName(name);
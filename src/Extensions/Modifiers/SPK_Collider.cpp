@@ -19,11 +19,45 @@
 // 3. This notice may not be removed or altered from any source distribution.	//
 //////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <SPARK_Core.h>
 #include "Extensions/Modifiers/SPK_Collider.h"
 
 namespace SPK
 {
+	class Collider::CollisionTask : public Task
+	{
+	public :
+
+		CollisionTask(const Collider& collider,Group& group,DataSet* dataSet) :
+			collider(collider),
+			group(group),
+			dataSet(dataSet),
+			applying(false)
+		{}
+
+		void setApplying(bool applying)
+		{
+			this->applying = applying;
+		}
+
+		virtual void execute(size_t jobIndex)
+		{
+			if (applying)
+				collider.applyResponses(group,dataSet,jobIndex);
+			else
+				collider.computeResponses(group,dataSet,jobIndex);
+		}
+
+	private :
+
+		const Collider& collider;
+		Group& group;
+		DataSet* dataSet;
+		bool applying;
+	};
+
 	void Collider::setElasticity(float elasticity)
 	{
 		if (elasticity < 0.0f)
@@ -35,12 +69,41 @@ namespace SPK
 		this->elasticity = elasticity;
 	}
 
+	void Collider::createData(DataSet& dataSet,const Group& group) const
+	{
+		dataSet.init(NB_DATA);
+		checkData(dataSet,group);
+	}
+
+	void Collider::checkData(DataSet& dataSet,const Group& group) const
+	{
+		// The buffers of the parallel mode only exist while it is enabled
+		if (parallel && dataSet.getData(VELOCITY_DELTA_INDEX) == NULL)
+		{
+			dataSet.setData(VELOCITY_DELTA_INDEX,SPK_NEW(Vector3DArrayData,group.getCapacity(),1));
+			dataSet.setData(RESET_INDEX,SPK_NEW(FloatArrayData,group.getCapacity(),1));
+		}
+		else if (!parallel && dataSet.getData(VELOCITY_DELTA_INDEX) != NULL)
+		{
+			dataSet.destroyData(VELOCITY_DELTA_INDEX);
+			dataSet.destroyData(RESET_INDEX);
+		}
+	}
+
 	void Collider::modify(Group& group,DataSet* dataSet,float deltaTime) const
 	{
+		if (parallel)
+		{
+			modifyParallel(group,dataSet);
+			return;
+		}
+
 		float groupSqrRadius = group.getPhysicalRadius() * group.getPhysicalRadius();
-		SPK_ASSERT(group.getOctree() != NULL,"GLQuadRenderer::render(const Group&,const DataSet*,RenderBuffer*) - renderBuffer must not be NULL");
-		const Octree& octree = *group.getOctree();
+		SPK_ASSERT(group.getSpatialIndex() != NULL,"Collider::modify(Group&,DataSet*,float) - The group has no spatial index");
+		const SpatialIndex& spatialIndex = *group.getSpatialIndex();
+		const float maxRadius = spatialIndex.getMaxRadius();
 
+		std::vector<size_t> neighborBuckets;
 		for (GroupIterator particleIt0(group); !particleIt0.end(); ++particleIt0)
 		{
 			Particle& particle0 = *particleIt0;
@@ -49,17 +112,18 @@ namespace SPK
 
 			size_t index0 = particle0.getIndex();
 
-			const Octree::Array<size_t>& neighborCells = octree.getNeighborCells(index0);
-			size_t nbCells = neighborCells.size();
+			// Particles colliding with this one are within its radius plus the radius of the largest particle
+			spatialIndex.getNeighborBuckets(particle0.position(),radius0 * group.getPhysicalRadius() + maxRadius,neighborBuckets);
+			size_t nbBuckets = neighborBuckets.size();
 
-			for (size_t i = 0; i < nbCells; ++i) // For each neighboring cell in the octree
+			for (size_t i = 0; i < nbBuckets; ++i) // For each neighboring bucket in the spatial index
 			{
-				const Octree::Cell& cell = octree.getCell(neighborCells[i]);
-				size_t nbParticleInCells = cell.particles.size();
+				size_t nbParticlesInBucket = 0;
+				const unsigned int* bucketParticles = spatialIndex.getParticles(neighborBuckets[i],nbParticlesInBucket);
 
-				for (size_t j = 0; j < nbParticleInCells; ++j) // for each particles in the cell
+				for (size_t j = 0; j < nbParticlesInBucket; ++j) // for each particles in the bucket
 				{
-					size_t index1 = cell.particles[j];
+					size_t index1 = bucketParticles[j];
 					if (index1 >= index0)
 						break; // as particle are ordered
 
@@ -129,7 +193,7 @@ namespace SPK
 								particle1.velocity() -= (1.0f + (elasticityM0 - m1) * invM01) * normal1;
 
 								normal0 *= (elasticityM0 + m0) * invM01;
-								normal1 *= (elasticityM1 + m0) * invM01;
+								normal1 *= (elasticityM1 + m1) * invM01;
 
 								particle0.velocity() += normal1;
 								particle1.velocity() += normal0;
@@ -140,4 +204,164 @@ namespace SPK
 			}
 		}
 	}
+
+	void Collider::modifyParallel(Group& group,DataSet* dataSet) const
+	{
+		SPK_ASSERT(group.getSpatialIndex() != NULL,"Collider::modifyParallel(Group&,DataSet*) - The group has no spatial index");
+
+		const size_t nbJobs = (group.getNbParticles() + COLLISION_JOB_SIZE - 1) / COLLISION_JOB_SIZE;
+		TaskManager* taskManager = group.getTaskManager();
+		CollisionTask task(*this,group,dataSet);
+
+		// All the responses are computed before any is applied so that they only depend on the state at the start of the update
+		for (size_t pass = 0; pass < 2; ++pass)
+		{
+			task.setApplying(pass == 1);
+			if (taskManager != NULL && nbJobs > 1)
+				taskManager->execute(task,nbJobs);
+			else
+				for (size_t i = 0; i < nbJobs; ++i)
+					task.execute(i);
+		}
+	}
+
+	void Collider::computeResponses(Group& group,DataSet* dataSet,size_t job) const
+	{
+		const SpatialIndex& spatialIndex = *group.getSpatialIndex();
+		const float physicalRadius = group.getPhysicalRadius();
+		const float groupSqrRadius = physicalRadius * physicalRadius;
+		const float maxRadius = spatialIndex.getMaxRadius();
+
+		Vector3D* velocityDeltas = SPK_GET_DATA(Vector3DArrayData,dataSet,VELOCITY_DELTA_INDEX).getData();
+		float* resets = SPK_GET_DATA(FloatArrayData,dataSet,RESET_INDEX).getData();
+
+		const size_t start = job * COLLISION_JOB_SIZE;
+		const size_t end = std::min(start + COLLISION_JOB_SIZE,group.getNbParticles());
+
+		// The coordinates of the neighbors are packed so that their distances are computed in SIMD
+		std::vector<size_t> neighborBuckets;
+		std::vector<unsigned int> neighbors;
+		std::vector<float> neighborsX;
+		std::vector<float> neighborsY;
+		std::vector<float> neighborsZ;
+		std::vector<float> sqrDists;
+
+		for (size_t index0 = start; index0 < end; ++index0)
+		{
+			const Particle particle0 = group.getParticle(index0);
+			const Vector3D& position0 = particle0.position();
+			const Vector3D& velocity0 = particle0.velocity();
+			const float radius0 = particle0.getParam(PARAM_SCALE);
+			const float m0 = particle0.getParam(PARAM_MASS);
+
+			// Particles colliding with this one are within its radius plus the radius of the largest particle
+			const float maxDist = radius0 * physicalRadius + maxRadius;
+			spatialIndex.getNeighborBuckets(position0,maxDist,neighborBuckets);
+
+			neighbors.clear();
+			neighborsX.clear();
+			neighborsY.clear();
+			neighborsZ.clear();
+			for (size_t i = 0; i < neighborBuckets.size(); ++i)
+			{
+				size_t nbParticlesInBucket = 0;
+				const unsigned int* bucketParticles = spatialIndex.getParticles(neighborBuckets[i],nbParticlesInBucket);
+
+				for (size_t j = 0; j < nbParticlesInBucket; ++j)
+					if (bucketParticles[j] != index0)
+					{
+						const Vector3D& position1 = group.getParticle(bucketParticles[j]).position();
+						neighbors.push_back(bucketParticles[j]);
+						neighborsX.push_back(position1.x);
+						neighborsY.push_back(position1.y);
+						neighborsZ.push_back(position1.z);
+					}
+			}
+
+			const size_t nbNeighbors = neighbors.size();
+			sqrDists.resize(nbNeighbors);
+			if (nbNeighbors > 0)
+				kernelSqrDistances(&sqrDists[0],&neighborsX[0],&neighborsY[0],&neighborsZ[0],position0.x,position0.y,position0.z,nbNeighbors);
+
+			// Only the response of this particle is summed up, the other particle of each pair computes its own
+			Vector3D velocityDelta;
+			bool reset = false;
+			const float sqrMaxDist = maxDist * maxDist;
+
+			for (size_t i = 0; i < nbNeighbors; ++i)
+			{
+				const float sqrDist = sqrDists[i];
+				if (sqrDist >= sqrMaxDist)
+					continue;
+
+				const Particle particle1 = group.getParticle(neighbors[i]);
+				const float radius1 = particle1.getParam(PARAM_SCALE);
+
+				float sqrRadius = radius0 + radius1;
+				sqrRadius *= sqrRadius * groupSqrRadius;
+
+				if (sqrDist >= sqrRadius)
+					continue;
+
+				// The tests are symmetric so that both particles of a pair agree on the collision
+				Vector3D normal = position0 - particle1.position();
+				const Vector3D delta = velocity0 - particle1.velocity();
+
+				if (dotProduct(normal,delta) >= 0.0f) // particles are not moving towards each other
+					continue;
+
+				const float oldSqrDist = getSqrDist(particle0.oldPosition(),particle1.oldPosition());
+				if (oldSqrDist > sqrDist)
+				{
+					// The move from this frame is disabled once all the responses are computed
+					reset = true;
+					normal = particle0.oldPosition() - particle1.oldPosition();
+
+					if (dotProduct(normal,delta) >= 0.0f)
+						continue;
+				}
+
+				normal.normalize();
+
+				// Gets the normal components of the velocities
+				const float normalSpeed0 = dotProduct(normal,velocity0);
+				const float normalSpeed1 = dotProduct(normal,particle1.velocity());
+
+				if (oldSqrDist < sqrRadius)
+				{
+					// Particles intersecting at both t - deltaTime and t are pushed apart
+					if (normalSpeed0 < 0.0f)
+						velocityDelta -= normal * normalSpeed0;
+					if (normalSpeed1 > 0.0f)
+						velocityDelta += normal * normalSpeed1;
+				}
+				else
+				{
+					// Classic collision equations, the tangent component of the velocity is left untouched
+					const float m1 = particle1.getParam(PARAM_MASS);
+					velocityDelta += normal * ((normalSpeed1 - normalSpeed0) * (1.0f + elasticity) * m1 / (m0 + m1));
+				}
+			}
+
+			velocityDeltas[index0] = velocityDelta;
+			resets[index0] = reset ? 1.0f : 0.0f;
+		}
+	}
+
+	void Collider::applyResponses(Group& group,DataSet* dataSet,size_t job) const
+	{
+		const Vector3D* velocityDeltas = SPK_GET_DATA(Vector3DArrayData,dataSet,VELOCITY_DELTA_INDEX).getData();
+		const float* resets = SPK_GET_DATA(FloatArrayData,dataSet,RESET_INDEX).getData();
+
+		const size_t start = job * COLLISION_JOB_SIZE;
+		const size_t end = std::min(start + COLLISION_JOB_SIZE,group.getNbParticles());
+
+		for (size_t i = start; i < end; ++i)
+		{
+			Particle particle = group.getParticle(i);
+			particle.velocity() += velocityDeltas[i];
+			if (resets[i] != 0.0f)
+				particle.position() = particle.oldPosition();
+		}
+	}
 }
@@ -54,6 +54,18 @@ namespace SPK
 		SPK_DELETE_ARRAY(data);
 	}
 
+	bool EmitterAttacher::EmitterData::resize(size_t capacity,size_t nbParticles)
+	{
+		Ref<Emitter>* newData = SPK_NEW_ARRAY(Ref<Emitter>,capacity);
+		for (size_t i = 0; i < nbParticles && i < capacity && i < dataSize; ++i)
+			swap(newData[i],data[i]); // Transfers the references without changing their counts
+
+		SPK_DELETE_ARRAY(data);
+		data = newData;
+		dataSize = capacity;
+		return true;
+	}
+
 	void EmitterAttacher::createData(DataSet& dataSet,const Group& group) const
 	{
 		dataSet.init(NB_DATA);
@@ -25,7 +25,7 @@
 namespace SPK
 {
 	LinearForce::LinearForce(const Vector3D& value,const Ref<Zone>& zone,ZoneTest zoneTest) :
-		ZonedModifier(MODIFIER_PRIORITY_FORCE,false,false,false,ZONE_TEST_FLAG_ALWAYS | ZONE_TEST_FLAG_INSIDE | ZONE_TEST_FLAG_OUTSIDE,zoneTest,zone),
+		ZonedModifier(MODIFIER_PRIORITY_FORCE,false,false,false,ZONE_TEST_FLAG_ALWAYS | ZONE_TEST_FLAG_INSIDE | ZONE_TEST_FLAG_OUTSIDE,zoneTest,zone,true),
 		relative(false),
 		squaredSpeed(false),
 		param(PARAM_SCALE),
@@ -130,7 +130,49 @@ namespace SPK
 		return discreteFactor;
 	}
 
+	float LinearForce::getMaxAcceleration(const Group& group) const
+	{
+		const float infinity = std::numeric_limits<float>::infinity();
+
+		// A relative force depends on the velocity of the particles
+		if (relative)
+			return infinity;
+
+		float maxAcceleration = std::abs(coef) * tValue.getNorm();
+		if (param == PARAM_SCALE)
+			for (int i = 0; i < factor; ++i)
+				maxAcceleration *= group.getPhysicalRadius();
+
+		if (param == PARAM_MASS && factor == FACTOR_LINEAR) // gravity type force
+			return maxAcceleration;
+
+		float minValue,maxValue;
+		if (factor != FACTOR_CONSTANT && group.isEnabled(param))
+		{
+			if (!group.getParamBounds(param,minValue,maxValue))
+				return infinity;
+
+			const float maxParam = std::max(std::abs(minValue),std::abs(maxValue));
+			for (int i = 0; i < factor; ++i)
+				maxAcceleration *= maxParam;
+		}
+
+		if (group.isEnabled(PARAM_MASS))
+		{
+			if (!group.getParamBounds(PARAM_MASS,minValue,maxValue) || minValue <= 0.0f)
+				return infinity;
+			maxAcceleration /= minValue;
+		}
+
+		return maxAcceleration;
+	}
+
 	void LinearForce::modify(Group& group,DataSet* dataSet,float deltaTime) const
+	{
+		modifyChunk(group,dataSet,deltaTime,0,group.getNbParticles());
+	}
+
+	void LinearForce::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
 	{
 		// Optimization to compute the factor only if needed
 		bool factorByParticle = true;
@@ -151,20 +193,20 @@ namespace SPK
 
 			if (!factorByParticle)
 			{
-				for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+				for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 					if (checkZone(*particleIt))
 						particleIt->velocity() += discreteForce;
 			}
 			else
 			{
-				for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+				for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 					if (checkZone(*particleIt))
 						particleIt->velocity() += discreteForce * getDiscreteFactor(*particleIt);
 			}
 		}
 		else
 		{
-			for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+			for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 				if (checkZone(*particleIt))
 				{
 					Particle& particle = *particleIt;
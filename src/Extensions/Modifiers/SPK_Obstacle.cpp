@@ -25,7 +25,7 @@
 namespace SPK
 {
 	Obstacle::Obstacle(const Ref<Zone>& zone,float bouncingRatio,float friction,ZoneTest zoneTest) :
-		ZonedModifier(MODIFIER_PRIORITY_COLLISION,false,true,false,ZONE_TEST_FLAG_ALL & ~ZONE_TEST_FLAG_ALWAYS/*ZONE_TEST_FLAG_INTERSECT | ZONE_TEST_FLAG_ENTER | ZONE_TEST_FLAG_LEAVE*/,zoneTest,zone),
+		ZonedModifier(MODIFIER_PRIORITY_COLLISION,false,true,false,ZONE_TEST_FLAG_ALL & ~ZONE_TEST_FLAG_ALWAYS/*ZONE_TEST_FLAG_INTERSECT | ZONE_TEST_FLAG_ENTER | ZONE_TEST_FLAG_LEAVE*/,zoneTest,zone,true),
 		bouncingRatio(bouncingRatio),
 		friction(friction)
 	{}
@@ -49,9 +49,14 @@ namespace SPK
 	}
 
 	void Obstacle::modify(Group& group,DataSet* dataSet,float deltaTime) const
+	{
+		modifyChunk(group,dataSet,deltaTime,0,group.getNbParticles());
+	}
+
+	void Obstacle::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
 	{
 		Vector3D normal;
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 		{
 			if (checkZone(*particleIt,&normal))
 			{ 
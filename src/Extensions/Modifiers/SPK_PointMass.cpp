@@ -25,7 +25,7 @@
 namespace SPK
 {
 	PointMass::PointMass(const Vector3D& pos,float mass,float offset) :
-		Modifier(MODIFIER_PRIORITY_FORCE,false,false,false),
+		Modifier(MODIFIER_PRIORITY_FORCE,false,false,false,true),
 		mass(mass)
 	{
 		setPosition(pos);
@@ -51,12 +51,23 @@ namespace SPK
 		this->offset = offset;
 	}
 
+	float PointMass::getMaxAcceleration(const Group& group) const
+	{
+		// mass * d / (d * d + offset * offset) is the greatest at d = offset
+		return std::abs(mass) / (2.0f * offset);
+	}
+
 	void PointMass::modify(Group& group,DataSet* dataSet,float deltaTime) const
+	{
+		modifyChunk(group,dataSet,deltaTime,0,group.getNbParticles());
+	}
+
+	void PointMass::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
 	{
 		float sqrOffset = offset * offset;
 		float massSecond = mass * deltaTime;
 
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 		{
 			Particle& particle = *particleIt;
 			Vector3D force = tPosition - particle.position();
@@ -102,6 +102,25 @@ namespace SPK
 		*SPK_GET_DATA(FloatArrayData,dataSet,REMAINING_TIME_INDEX).getParticleData(index) = SPK_RANDOM(minPeriod,maxPeriod);
 	}
 
+	float RandomForce::getMaxAcceleration(const Group& group) const
+	{
+		Vector3D maxForce(
+			std::max(std::abs(tMinVector.x),std::abs(tMaxVector.x)),
+			std::max(std::abs(tMinVector.y),std::abs(tMaxVector.y)),
+			std::max(std::abs(tMinVector.z),std::abs(tMaxVector.z)));
+		float maxAcceleration = maxForce.getNorm();
+
+		if (group.isEnabled(PARAM_MASS))
+		{
+			float minMass,maxMass;
+			if (!group.getParamBounds(PARAM_MASS,minMass,maxMass) || minMass <= 0.0f)
+				return std::numeric_limits<float>::infinity();
+			maxAcceleration /= minMass;
+		}
+
+		return maxAcceleration;
+	}
+
 	void RandomForce::modify(Group& group,DataSet* dataSet,float deltaTime) const
 	{
 		Vector3D* forceIt = SPK_GET_DATA(Vector3DArrayData,dataSet,FORCE_VECTOR_INDEX).getData();
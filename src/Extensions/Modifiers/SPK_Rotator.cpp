@@ -25,9 +25,14 @@
 namespace SPK
 {
 	void Rotator::modify(Group& group,DataSet* dataSet,float deltaTime) const
+	{
+		modifyChunk(group,dataSet,deltaTime,0,group.getNbParticles());
+	}
+
+	void Rotator::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
 	{
 		if (group.isEnabled(PARAM_ANGLE) && group.isEnabled(PARAM_ROTATION_SPEED))
-			for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+			for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 			{
 				float angle = particleIt->getParamNC(PARAM_ANGLE) + particleIt->getParamNC(PARAM_ROTATION_SPEED) * deltaTime;
 				particleIt->setParamNC(PARAM_ANGLE,angle);
@@ -25,7 +25,7 @@
 namespace SPK
 {
 	Vortex::Vortex(const Vector3D& position,const Vector3D& direction,float rotationSpeed,float attractionSpeed) :
-		Modifier(MODIFIER_PRIORITY_POSITION,false,false,false),
+		Modifier(MODIFIER_PRIORITY_POSITION,false,false,false,true),
 		rotationSpeed(rotationSpeed),
 		attractionSpeed(attractionSpeed),
 		angularSpeedEnabled(false),
@@ -62,7 +62,12 @@ namespace SPK
 
 	void Vortex::modify(Group& group,DataSet* dataSet,float deltaTime) const
 	{
-		for (GroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		modifyChunk(group,dataSet,deltaTime,0,group.getNbParticles());
+	}
+
+	void Vortex::modifyChunk(Group& group,DataSet* dataSet,float deltaTime,size_t start,size_t end) const
+	{
+		for (GroupIterator particleIt(group,start,end); !particleIt.end(); ++particleIt)
 		{
 			Particle& particle = *particleIt;
 
@@ -81,7 +86,7 @@ namespace SPK
 			{
 				if (killingParticleEnabled)
 					particle.kill();
-				return;
+				continue;
 			}
 		
 			float angle = angularSpeedEnabled ? rotationSpeed * deltaTime : rotationSpeed * deltaTime / dist;
@@ -199,6 +199,20 @@ namespace SPK
 		return ratio[axisIndex] > 0.0f ? -tAxis[axisIndex] : tAxis[axisIndex];
 	}
 
+	void Box::computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		Vector3D extent;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			Vector3D axisExtent(tAxis[i]);
+			axisExtent.abs();
+			extent += axisExtent * halfDimensions[i];
+		}
+
+		AABBMin = getTransformedPosition() - extent;
+		AABBMax = getTransformedPosition() + extent;
+	}
+
 	void Box::innerUpdateTransform()
 	{
 		Zone::innerUpdateTransform();
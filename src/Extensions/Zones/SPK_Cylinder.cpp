@@ -19,6 +19,8 @@
 // 3. This notice may not be removed or altered from any source distribution.	//
 //////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm> // for std::max
+
 #include <SPARK_Core.h>
 #include "Extensions/Zones/SPK_Cylinder.h"
 
@@ -140,6 +142,17 @@ namespace SPK
 		}
 	}
 
+	void Cylinder::computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		// Extent of the axis plus extent of the disks on each coordinate
+		Vector3D extent;
+		for (size_t i = 0; i < 3; ++i)
+			extent[i] = std::abs(tAxis[i]) * height * 0.5f + radius * std::sqrt(std::max(0.0f,1.0f - tAxis[i] * tAxis[i]));
+
+		AABBMin = getTransformedPosition() - extent;
+		AABBMax = getTransformedPosition() + extent;
+	}
+
 	void Cylinder::innerUpdateTransform()
 	{
 		Zone::innerUpdateTransform();
@@ -19,7 +19,7 @@
 // 3. This notice may not be removed or altered from any source distribution.	//
 //////////////////////////////////////////////////////////////////////////////////
 
-#include <algorithm> // for std::swap
+#include <algorithm> // for std::swap and std::max
 
 #include <SPARK_Core.h>
 #include "Extensions/Zones/SPK_Ring.h"
@@ -135,6 +135,17 @@ namespace SPK
 		return hasIntersection;
 	}
 
+	void Ring::computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		// Extent of a disk on each coordinate
+		Vector3D extent;
+		for (size_t i = 0; i < 3; ++i)
+			extent[i] = maxRadius * std::sqrt(std::max(0.0f,1.0f - tNormal[i] * tNormal[i]));
+
+		AABBMin = getTransformedPosition() - extent;
+		AABBMax = getTransformedPosition() + extent;
+	}
+
 	void Ring::innerUpdateTransform()
 	{
 		Zone::innerUpdateTransform();
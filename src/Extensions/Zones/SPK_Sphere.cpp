@@ -113,4 +113,11 @@ namespace SPK
 			normal.revert();
 		return normal;
 	}
+
+	void Sphere::computeBounds(Vector3D& AABBMin,Vector3D& AABBMax) const
+	{
+		const Vector3D extent(radius,radius,radius);
+		AABBMin = getTransformedPosition() - extent;
+		AABBMax = getTransformedPosition() + extent;
+	}
 }
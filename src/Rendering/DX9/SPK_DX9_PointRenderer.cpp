@@ -64,7 +64,7 @@ namespace DX9
 		buffer.positionAtStart(); // Repositions all the buffers at the start
 
 		buffer.lock(VERTEX_AND_COLOR_LOCK);
-		for( ConstGroupIterator particleIt(group); !particleIt.end(); ++particleIt )
+		for( ConstSortedGroupIterator particleIt(group); !particleIt.end(); ++particleIt )
 		{
 			buffer.setNextVertex(particleIt->position());
 			buffer.setNextColor(particleIt->getColor());
@@ -131,7 +131,10 @@ namespace scene
 		if (lastUpdatedTime == 0)
 			lastUpdatedTime = timeMs;
 
-        if (!onlyWhenVisible || IsVisible)
+		// A hidden system is not simulated but catches up with the time elapsed when visible again
+		SPKSystem->setVisible(!onlyWhenVisible || IsVisible);
+
+		if (SPKSystem->isVisible())
 		{
 			updateCameraPosition();
 
@@ -140,10 +143,10 @@ namespace scene
 				SPK_LOG_INFO("CSPKParticleSystemNode::OnAnimate(u32) - The culling is activated for the system but not the bounding box computation - BB computation is enabled");
 				SPKSystem->enableAABBComputation(true);
 			}
-
-			alive = SPKSystem->updateParticles((timeMs - lastUpdatedTime) * 0.001f);
 		}
 
+		alive = SPKSystem->updateParticles((timeMs - lastUpdatedTime) * 0.001f);
+
         lastUpdatedTime = timeMs;
 	}
 
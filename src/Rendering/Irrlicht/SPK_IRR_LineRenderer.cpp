@@ -62,7 +62,7 @@ namespace IRR
 		IRRBuffer& buffer = static_cast<IRRBuffer&>(*renderBuffer);
 		
 		buffer.positionAtStart();
-		for (ConstGroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+		for (ConstSortedGroupIterator particleIt(group); !particleIt.end(); ++particleIt)
 		{
 			buffer.setNextVertex(particleIt->position());
 			buffer.setNextVertex(particleIt->position() + particleIt->velocity() * length);
@@ -132,12 +132,12 @@ namespace IRR
 		{
 			computeGlobalOrientation3D(group);
 
-			for (ConstGroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+			for (ConstSortedGroupIterator particleIt(group); !particleIt.end(); ++particleIt)
 				(this->*renderParticle)(*particleIt,buffer);
 		}
 		else
 		{
-			for (ConstGroupIterator particleIt(group); !particleIt.end(); ++particleIt)
+			for (ConstSortedGroupIterator particleIt(group); !particleIt.end(); ++particleIt)
 			{
 				computeSingleOrientation3D(*particleIt);
 				(this->*renderParticle)(*particleIt,buffer);